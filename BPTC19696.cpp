@@ -19,25 +19,49 @@
 
 #include "BPTC19696.h"
 
+#include "BitPermutation.h"
 #include "Hamming.h"
-#include "Utils.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
+// The matrix is held as 13 rows of 15 bits, the first column in bit 14.
+// Position a of the deinterleaved data, counting the unused R(3) bit as
+// position 0, is row (a - 1) / 15 and column (a - 1) mod 15.
+
+// The bit of the 33 byte burst that carries each deinterleaved position,
+// which skips the slot type and sync between the two halves
+const unsigned int INTERLEAVE_TABLE[] = {
+	0U, 249U, 234U, 219U, 204U, 189U, 174U, 91U, 76U, 61U, 46U, 31U, 16U, 1U,
+	250U, 235U, 220U, 205U, 190U, 175U, 92U, 77U, 62U, 47U, 32U, 17U, 2U, 251U,
+	236U, 221U, 206U, 191U, 176U, 93U, 78U, 63U, 48U, 33U, 18U, 3U, 252U, 237U,
+	222U, 207U, 192U, 177U, 94U, 79U, 64U, 49U, 34U, 19U, 4U, 253U, 238U, 223U,
+	208U, 193U, 178U, 95U, 80U, 65U, 50U, 35U, 20U, 5U, 254U, 239U, 224U, 209U,
+	194U, 179U, 96U, 81U, 66U, 51U, 36U, 21U, 6U, 255U, 240U, 225U, 210U, 195U,
+	180U, 97U, 82U, 67U, 52U, 37U, 22U, 7U, 256U, 241U, 226U, 211U, 196U, 181U,
+	166U, 83U, 68U, 53U, 38U, 23U, 8U, 257U, 242U, 227U, 212U, 197U, 182U, 167U,
+	84U, 69U, 54U, 39U, 24U, 9U, 258U, 243U, 228U, 213U, 198U, 183U, 168U, 85U,
+	70U, 55U, 40U, 25U, 10U, 259U, 244U, 229U, 214U, 199U, 184U, 169U, 86U, 71U,
+	56U, 41U, 26U, 11U, 260U, 245U, 230U, 215U, 200U, 185U, 170U, 87U, 72U, 57U,
+	42U, 27U, 12U, 261U, 246U, 231U, 216U, 201U, 186U, 171U, 88U, 73U, 58U, 43U,
+	28U, 13U, 262U, 247U, 232U, 217U, 202U, 187U, 172U, 89U, 74U, 59U, 44U, 29U,
+	14U, 263U, 248U, 233U, 218U, 203U, 188U, 173U, 90U, 75U, 60U, 45U, 30U, 15U};
+
+// The 196 deinterleaved bits to and from the burst
+static const CBitPermutation<196U, 1U> PERMUTATION(INTERLEAVE_TABLE);
+
+// Row r starts at bit 15r + 1 of the deinterleaved data and lies within three bytes of it
+#define ROW_BYTE(r)  ((15U * (r) + 1U) >> 3)
+#define ROW_SHIFT(r) (9U - ((15U * (r) + 1U) & 7U))
+
 CBPTC19696::CBPTC19696() :
-m_rawData(NULL),
-m_deInterData(NULL)
+m_rows()
 {
-	m_rawData     = new bool[196];
-	m_deInterData = new bool[196];
 }
 
 CBPTC19696::~CBPTC19696()
 {
-	delete[] m_rawData;
-	delete[] m_deInterData;
 }
 
 // The main decode function
@@ -46,11 +70,8 @@ void CBPTC19696::decode(const unsigned char* in, unsigned char* out)
 	assert(in != NULL);
 	assert(out != NULL);
 
-	//  Get the raw binary
-	decodeExtractBinary(in);
-
 	// Deinterleave
-	decodeDeInterleave();
+	decodeDeInterleave(in);
 
 	// Error check
 	decodeErrorCheck();
@@ -71,98 +92,63 @@ void CBPTC19696::encode(const unsigned char* in, unsigned char* out)
 	// Error check
 	encodeErrorCheck();
 
-	// Deinterleave
-	encodeInterleave();
-
-	//  Get the raw binary
-	encodeExtractBinary(out);
+	// Interleave
+	encodeInterleave(out);
 }
 
-void CBPTC19696::decodeExtractBinary(const unsigned char* in)
+// Deinterleave the burst and cut it into rows, the first bit is R(3) which is not used so can be ignored
+void CBPTC19696::decodeDeInterleave(const unsigned char* in)
 {
-	// First block
-	CUtils::byteToBitsBE(in[0U],  m_rawData + 0U);
-	CUtils::byteToBitsBE(in[1U],  m_rawData + 8U);
-	CUtils::byteToBitsBE(in[2U],  m_rawData + 16U);
-	CUtils::byteToBitsBE(in[3U],  m_rawData + 24U);
-	CUtils::byteToBitsBE(in[4U],  m_rawData + 32U);
-	CUtils::byteToBitsBE(in[5U],  m_rawData + 40U);
-	CUtils::byteToBitsBE(in[6U],  m_rawData + 48U);
-	CUtils::byteToBitsBE(in[7U],  m_rawData + 56U);
-	CUtils::byteToBitsBE(in[8U],  m_rawData + 64U);
-	CUtils::byteToBitsBE(in[9U],  m_rawData + 72U);
-	CUtils::byteToBitsBE(in[10U], m_rawData + 80U);
-	CUtils::byteToBitsBE(in[11U], m_rawData + 88U);
-	CUtils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-	// Handle the two bits
-	bool bits[8U];
-	CUtils::byteToBitsBE(in[20U], bits);
-	m_rawData[98U] = bits[6U];
-	m_rawData[99U] = bits[7U];
-
-	// Second block
-	CUtils::byteToBitsBE(in[21U], m_rawData + 100U);
-	CUtils::byteToBitsBE(in[22U], m_rawData + 108U);
-	CUtils::byteToBitsBE(in[23U], m_rawData + 116U);
-	CUtils::byteToBitsBE(in[24U], m_rawData + 124U);
-	CUtils::byteToBitsBE(in[25U], m_rawData + 132U);
-	CUtils::byteToBitsBE(in[26U], m_rawData + 140U);
-	CUtils::byteToBitsBE(in[27U], m_rawData + 148U);
-	CUtils::byteToBitsBE(in[28U], m_rawData + 156U);
-	CUtils::byteToBitsBE(in[29U], m_rawData + 164U);
-	CUtils::byteToBitsBE(in[30U], m_rawData + 172U);
-	CUtils::byteToBitsBE(in[31U], m_rawData + 180U);
-	CUtils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
+	unsigned char bits[25U];
+	PERMUTATION.deinterleave(in, bits);
 
-// Deinterleave the raw data
-void CBPTC19696::decodeDeInterleave()
-{
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Shuffle the data
-		m_deInterData[a] = m_rawData[interleaveSequence];
+	for (unsigned int r = 0U; r < 13U; r++) {
+		const unsigned char* p = bits + ROW_BYTE(r);
+		unsigned int window = (p[0U] << 16) | (p[1U] << 8) | p[2U];
+
+		m_rows[r] = (window >> ROW_SHIFT(r)) & 0x7FFFU;
 	}
 }
-	
+
 // Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
 void CBPTC19696::decodeErrorCheck()
 {
+	const unsigned int* r = m_rows;
+
 	bool fixing;
 	unsigned int count = 0U;
 	do {
 		fixing = false;
 
-		// Run through each of the 15 columns
-		bool col[13U];
-		for (unsigned int c = 0U; c < 15U; c++) {
-			unsigned int pos = c + 1U;
-			for (unsigned int a = 0U; a < 13U; a++) {
-				col[a] = m_deInterData[pos];
-				pos = pos + 15U;
-			}
+		// The column checks of all 15 columns at once, only the columns with a non-zero syndrome need decoding
+		unsigned int errors = 0U;
+		errors |= r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U] ^ r[9U];
+		errors |= r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U] ^ r[10U];
+		errors |= r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U] ^ r[11U];
+		errors |= r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U] ^ r[12U];
+
+		for (unsigned int c = 0U; c < 15U && errors != 0U; c++) {
+			unsigned int shift = 14U - c;
+			if (((errors >> shift) & 0x01U) == 0x00U)
+				continue;
 
+			unsigned int col = 0U;
+			for (unsigned int a = 0U; a < 13U; a++)
+				col = (col << 1) | ((m_rows[a] >> shift) & 0x01U);
+
+			unsigned int original = col;
 			if (CHamming::decode1393(col)) {
-				unsigned int pos = c + 1U;
-				for (unsigned int a = 0U; a < 13U; a++) {
-					m_deInterData[pos] = col[a];
-					pos = pos + 15U;
-				}
+				unsigned int diff = col ^ original;
+				for (unsigned int a = 0U; a < 13U; a++)
+					m_rows[a] ^= ((diff >> (12U - a)) & 0x01U) << shift;
 
 				fixing = true;
 			}
 		}
 		
 		// Run through each of the 9 rows containing data
-		for (unsigned int r = 0U; r < 9U; r++) {
-			unsigned int pos = (r * 15U) + 1U;
-			if (CHamming::decode15113_2(m_deInterData + pos))
+		for (unsigned int a = 0U; a < 9U; a++) {
+			if (CHamming::decode15113_2(m_rows[a]))
 				fixing = true;
 		}
 
@@ -170,178 +156,76 @@ void CBPTC19696::decodeErrorCheck()
 	} while (fixing && count < 5U);
 }
 
-// Extract the 96 bits of payload
+// Extract the 96 bits of payload, 8 from the first row and 11 from each of the next eight
 void CBPTC19696::decodeExtractData(unsigned char* data) const
 {
-	bool bData[96U];
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	CUtils::bitsToByteBE(bData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(bData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(bData + 16U, data[2U]);
-	CUtils::bitsToByteBE(bData + 24U, data[3U]);
-	CUtils::bitsToByteBE(bData + 32U, data[4U]);
-	CUtils::bitsToByteBE(bData + 40U, data[5U]);
-	CUtils::bitsToByteBE(bData + 48U, data[6U]);
-	CUtils::bitsToByteBE(bData + 56U, data[7U]);
-	CUtils::bitsToByteBE(bData + 64U, data[8U]);
-	CUtils::bitsToByteBE(bData + 72U, data[9U]);
-	CUtils::bitsToByteBE(bData + 80U, data[10U]);
-	CUtils::bitsToByteBE(bData + 88U, data[11U]);
-}
+	data[0U] = (m_rows[0U] >> 4) & 0xFFU;
 
-// Extract the 96 bits of payload
-void CBPTC19696::encodeExtractData(const unsigned char* in) const
-{
-	bool bData[96U];
-	CUtils::byteToBitsBE(in[0U],  bData + 0U);
-	CUtils::byteToBitsBE(in[1U],  bData + 8U);
-	CUtils::byteToBitsBE(in[2U],  bData + 16U);
-	CUtils::byteToBitsBE(in[3U],  bData + 24U);
-	CUtils::byteToBitsBE(in[4U],  bData + 32U);
-	CUtils::byteToBitsBE(in[5U],  bData + 40U);
-	CUtils::byteToBitsBE(in[6U],  bData + 48U);
-	CUtils::byteToBitsBE(in[7U],  bData + 56U);
-	CUtils::byteToBitsBE(in[8U],  bData + 64U);
-	CUtils::byteToBitsBE(in[9U],  bData + 72U);
-	CUtils::byteToBitsBE(in[10U], bData + 80U);
-	CUtils::byteToBitsBE(in[11U], bData + 88U);
-
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		m_deInterData[a] = bData[pos];
+	unsigned int bits  = 0U;
+	unsigned int count = 0U;
+	unsigned int n = 1U;
+	for (unsigned int r = 1U; r < 9U; r++) {
+		bits = (bits << 11) | ((m_rows[r] >> 4) & 0x7FFU);
+		count += 11U;
+
+		while (count >= 8U) {
+			count -= 8U;
+			data[n++] = (bits >> count) & 0xFFU;
+		}
+	}
 }
 
-// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
-void CBPTC19696::encodeErrorCheck()
+// Load the 96 bits of payload, the rest of the matrix is zero
+void CBPTC19696::encodeExtractData(const unsigned char* in)
 {
-	
-	// Run through each of the 9 rows containing data
-	for (unsigned int r = 0U; r < 9U; r++) {
-		unsigned int pos = (r * 15U) + 1U;
-		CHamming::encode15113_2(m_deInterData + pos);
-	}
-	
-	// Run through each of the 15 columns
-	bool col[13U];
-	for (unsigned int c = 0U; c < 15U; c++) {
-		unsigned int pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			col[a] = m_deInterData[pos];
-			pos = pos + 15U;
-		}
+	::memset(m_rows, 0x00U, 13U * sizeof(unsigned int));
 
-		CHamming::encode1393(col);
+	m_rows[0U] = in[0U] << 4;
 
-		pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			m_deInterData[pos] = col[a];
-			pos = pos + 15U;
+	unsigned int bits  = 0U;
+	unsigned int count = 0U;
+	unsigned int n = 1U;
+	for (unsigned int r = 1U; r < 9U; r++) {
+		while (count < 11U) {
+			bits = (bits << 8) | in[n++];
+			count += 8U;
 		}
+
+		count -= 11U;
+		m_rows[r] = ((bits >> count) & 0x7FFU) << 4;
 	}
 }
 
-// Interleave the raw data
-void CBPTC19696::encodeInterleave()
+// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
+void CBPTC19696::encodeErrorCheck()
 {
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_rawData[i] = false;
-
-	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Unshuffle the data
-		m_rawData[interleaveSequence] = m_deInterData[a];
-	}
+	unsigned int* r = m_rows;
+
+	// Run through each of the 9 rows containing data
+	for (unsigned int a = 0U; a < 9U; a++)
+		CHamming::encode15113_2(r[a]);
+
+	// The column checks of all 15 columns at once, each one is a row of its own
+	r[9U]  = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U];
+	r[10U] = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U];
+	r[11U] = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U];
+	r[12U] = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U];
 }
 
-void CBPTC19696::encodeExtractBinary(unsigned char* data)
+// Join the rows and interleave them into the burst, R(3) is sent as zero
+void CBPTC19696::encodeInterleave(unsigned char* data) const
 {
-	// First block
-	CUtils::bitsToByteBE(m_rawData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_rawData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_rawData + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_rawData + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_rawData + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_rawData + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_rawData + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_rawData + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_rawData + 64U, data[8U]);
-	CUtils::bitsToByteBE(m_rawData + 72U, data[9U]);
-	CUtils::bitsToByteBE(m_rawData + 80U, data[10U]);
-	CUtils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-	// Handle the two bits
-	unsigned char byte;
-	CUtils::bitsToByteBE(m_rawData + 96U, byte);
-	data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-	data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-	// Second block
-	CUtils::bitsToByteBE(m_rawData + 100U,  data[21U]);
-	CUtils::bitsToByteBE(m_rawData + 108U,  data[22U]);
-	CUtils::bitsToByteBE(m_rawData + 116U,  data[23U]);
-	CUtils::bitsToByteBE(m_rawData + 124U,  data[24U]);
-	CUtils::bitsToByteBE(m_rawData + 132U,  data[25U]);
-	CUtils::bitsToByteBE(m_rawData + 140U,  data[26U]);
-	CUtils::bitsToByteBE(m_rawData + 148U,  data[27U]);
-	CUtils::bitsToByteBE(m_rawData + 156U,  data[28U]);
-	CUtils::bitsToByteBE(m_rawData + 164U,  data[29U]);
-	CUtils::bitsToByteBE(m_rawData + 172U,  data[30U]);
-	CUtils::bitsToByteBE(m_rawData + 180U,  data[31U]);
-	CUtils::bitsToByteBE(m_rawData + 188U,  data[32U]);
+	unsigned char bits[25U];
+	::memset(bits, 0x00U, 25U);
+
+	for (unsigned int r = 0U; r < 13U; r++) {
+		unsigned char* p = bits + ROW_BYTE(r);
+		unsigned int window = m_rows[r] << ROW_SHIFT(r);
+
+		p[0U] |= window >> 16;
+		p[1U] |= window >> 8;
+		p[2U] |= window;
+	}
+
+	PERMUTATION.interleave(bits, data);
 }
@@ -30,18 +30,15 @@ public:
 	void encode(const unsigned char* in, unsigned char* out);
 
 private:
-	bool* m_rawData;
-	bool* m_deInterData;
+	unsigned int m_rows[13U];
 
-	void decodeExtractBinary(const unsigned char* in);
+	void decodeDeInterleave(const unsigned char* in);
 	void decodeErrorCheck();
-	void decodeDeInterleave();
 	void decodeExtractData(unsigned char* data) const;
 
-	void encodeExtractData(const unsigned char* in) const;
-	void encodeInterleave();
+	void encodeExtractData(const unsigned char* in);
 	void encodeErrorCheck();
-	void encodeExtractBinary(unsigned char* data);
+	void encodeInterleave(unsigned char* data) const;
 };
 
 #endif
@@ -0,0 +1,153 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(BITPERMUTATION_H)
+#define	BITPERMUTATION_H
+
+#include <cassert>
+#include <cstring>
+
+// Moves bits between a sequential stream and an interleaved buffer. Entry
+// i of the table gives the interleaved position of the WIDTH stream bits
+// starting at i * WIDTH, bits are numbered from the top of the first byte.
+// The table is compiled once into a gather program per direction, one
+// step per output byte with the eight source bits of that byte, so a
+// permutation is a fixed sequence of shifts with no per-bit branches.
+// Bits of the output that the table does not cover are left untouched.
+template<unsigned int COUNT, unsigned int WIDTH> class CBitPermutation {
+public:
+	CBitPermutation(const unsigned int (&table)[COUNT]) :
+	m_interleave(NULL),
+	m_interleaveCount(0U),
+	m_deinterleave(NULL),
+	m_deinterleaveCount(0U)
+	{
+		unsigned int src[COUNT * WIDTH];
+		unsigned int dst[COUNT * WIDTH];
+
+		for (unsigned int i = 0U; i < COUNT; i++) {
+			for (unsigned int j = 0U; j < WIDTH; j++) {
+				src[i * WIDTH + j] = i * WIDTH + j;
+				dst[i * WIDTH + j] = table[i] + j;
+			}
+		}
+
+		compile(src, dst, m_interleave, m_interleaveCount);
+		compile(dst, src, m_deinterleave, m_deinterleaveCount);
+	}
+
+	~CBitPermutation()
+	{
+		delete[] m_interleave;
+		delete[] m_deinterleave;
+	}
+
+	// Sequential stream to interleaved buffer
+	void interleave(const unsigned char* in, unsigned char* out) const
+	{
+		run(m_interleave, m_interleaveCount, in, out);
+	}
+
+	// Interleaved buffer to sequential stream
+	void deinterleave(const unsigned char* in, unsigned char* out) const
+	{
+		run(m_deinterleave, m_deinterleaveCount, in, out);
+	}
+
+private:
+	struct CStep {
+		unsigned int  m_byte;
+		unsigned char m_mask;
+		unsigned int  m_srcByte[8U];
+		unsigned char m_srcShift[8U];
+	};
+
+	CStep*       m_interleave;
+	unsigned int m_interleaveCount;
+	CStep*       m_deinterleave;
+	unsigned int m_deinterleaveCount;
+
+	static void compile(const unsigned int* from, const unsigned int* to, CStep*& steps, unsigned int& count)
+	{
+		const unsigned int BITS = COUNT * WIDTH;
+
+		unsigned int bytes = 0U;
+		for (unsigned int i = 0U; i < BITS; i++) {
+			if (to[i] / 8U + 1U > bytes)
+				bytes = to[i] / 8U + 1U;
+		}
+
+		// One step for every output byte with at least one bit in the table
+		CStep* all = new CStep[bytes];
+		::memset(all, 0x00U, bytes * sizeof(CStep));
+
+		for (unsigned int i = 0U; i < BITS; i++) {
+			CStep& step = all[to[i] / 8U];
+			unsigned int k = to[i] % 8U;
+
+			assert((step.m_mask & (0x80U >> k)) == 0U);
+
+			step.m_mask       |= 0x80U >> k;
+			step.m_srcByte[k]  = from[i] / 8U;
+			step.m_srcShift[k] = 7U - from[i] % 8U;
+		}
+
+		count = 0U;
+		for (unsigned int i = 0U; i < bytes; i++) {
+			if (all[i].m_mask != 0x00U)
+				count++;
+		}
+
+		steps = new CStep[count];
+
+		unsigned int n = 0U;
+		for (unsigned int i = 0U; i < bytes; i++) {
+			if (all[i].m_mask != 0x00U) {
+				steps[n] = all[i];
+				steps[n].m_byte = i;
+				n++;
+			}
+		}
+
+		delete[] all;
+	}
+
+	static void run(const CStep* steps, unsigned int count, const unsigned char* in, unsigned char* out)
+	{
+		assert(in != NULL);
+		assert(out != NULL);
+
+		for (unsigned int i = 0U; i < count; i++) {
+			const CStep& step = steps[i];
+
+			unsigned int b = 0U;
+			for (unsigned int k = 0U; k < 8U; k++)
+				b = (b << 1) | ((in[step.m_srcByte[k]] >> step.m_srcShift[k]) & 0x01U);
+
+			if (step.m_mask == 0xFFU)
+				out[step.m_byte] = b;
+			else
+				out[step.m_byte] = (out[step.m_byte] & ~step.m_mask) | (b & step.m_mask);
+		}
+	}
+
+	CBitPermutation(const CBitPermutation&);
+	CBitPermutation& operator=(const CBitPermutation&);
+};
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "YSFConvolution.h"
+#include "Utils.h"
+#include "CPU.h"
+
+#include <cstdio>
+#include <cassert>
+
+#if defined(_MSC_VER) && defined(CPU_X86)
+#include <intrin.h>
+#endif
+
+const char* LEVEL_NAMES[] = {"scalar", "sse2", "bmi2", "neon"};
+
+const unsigned int LEVEL_COUNT = 4U;
+
+static CPU_LEVEL selectedLevel = CPU_SCALAR;
+
+#if defined(CPU_X86)
+static bool hasSSE2()
+{
+#if defined(_MSC_VER)
+	int info[4U];
+	::__cpuid(info, 1);
+
+	return (info[3U] & (1 << 26)) != 0;
+#else
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+#endif
+
+#if defined(CPU_X86_64)
+static bool hasBMI2()
+{
+#if defined(_MSC_VER)
+	int info[4U];
+	::__cpuid(info, 0);
+	if (info[0U] < 7)
+		return false;
+
+	::__cpuidex(info, 7, 0);
+
+	return (info[1U] & (1 << 8)) != 0;
+#else
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("bmi2") != 0;
+#endif
+}
+#endif
+
+// BMI2 is only used with --cpu=bmi2, as PDEP and PEXT are microcoded and
+// slow on AMD processors before Zen 3. The NEON kernels are only built with
+// USE_NEON and, until ViterbiBench and ModeConvBench have been run on ARM,
+// also need --cpu=neon.
+CPU_LEVEL CCPU::probe()
+{
+	if (isSupported(CPU_SSE2))
+		return CPU_SSE2;
+
+	return CPU_SCALAR;
+}
+
+bool CCPU::isSupported(CPU_LEVEL level)
+{
+	switch (level) {
+		case CPU_SCALAR:
+			return true;
+#if defined(CPU_X86)
+		case CPU_SSE2:
+			return hasSSE2();
+#endif
+#if defined(CPU_X86_64)
+		case CPU_BMI2:
+			return hasSSE2() && hasBMI2();
+#endif
+#if defined(CPU_ARM_NEON)
+		case CPU_NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+void CCPU::select(CPU_LEVEL level)
+{
+	assert(isSupported(level));
+
+	selectedLevel = level;
+
+	CYSFConvolution::setLevel(level);
+	CUtils::setLevel(level);
+}
+
+CPU_LEVEL CCPU::getSelected()
+{
+	return selectedLevel;
+}
+
+const char* CCPU::getName(CPU_LEVEL level)
+{
+	assert((unsigned int)level < LEVEL_COUNT);
+
+	return LEVEL_NAMES[level];
+}
+
+bool CCPU::find(const std::string& name, CPU_LEVEL& level)
+{
+	for (unsigned int i = 0U; i < LEVEL_COUNT; i++) {
+		if (name == LEVEL_NAMES[i]) {
+			level = CPU_LEVEL(i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::string CCPU::getSupported()
+{
+	std::string names;
+
+	for (unsigned int i = 0U; i < LEVEL_COUNT; i++) {
+		if (!isSupported(CPU_LEVEL(i)))
+			continue;
+
+		if (!names.empty())
+			names += " ";
+		names += LEVEL_NAMES[i];
+	}
+
+	return names;
+}
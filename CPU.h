@@ -0,0 +1,75 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(CPU_H)
+#define	CPU_H
+
+#include <string>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#define	CPU_X86
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define	CPU_X86_64
+#endif
+
+// The NEON kernels have not yet been built or run on ARM hardware, so they
+// are left out unless asked for with make USE_NEON=1
+#if defined(USE_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define	CPU_ARM_NEON
+#endif
+
+// Lets a function use instructions beyond those the build targets
+#if defined(__GNUC__)
+#define	CPU_TARGET(x)	__attribute__((target(x)))
+#else
+#define	CPU_TARGET(x)
+#endif
+
+// The kernel versions that can be selected. A level also uses the best
+// kernels of the levels below it for the same architecture.
+enum CPU_LEVEL {
+	CPU_SCALAR,
+	CPU_SSE2,
+	CPU_BMI2,
+	CPU_NEON
+};
+
+// Chooses which versions of the FEC and bit handling kernels are used.
+// This is done once at start-up, before any other thread is running.
+class CCPU {
+public:
+	// The level used when none is given with --cpu
+	static CPU_LEVEL probe();
+
+	static bool isSupported(CPU_LEVEL level);
+
+	// Points every kernel at its version for the level
+	static void select(CPU_LEVEL level);
+
+	static CPU_LEVEL getSelected();
+
+	static const char* getName(CPU_LEVEL level);
+	static bool find(const std::string& name, CPU_LEVEL& level);
+
+	// The names of the supported levels, separated by spaces
+	static std::string getSupported();
+};
+
+#endif
@@ -44,6 +44,8 @@ m_dstPort(0U),
 m_localAddress(),
 m_localPort(0U),
 m_daemon(false),
+m_eventLoop(false),
+m_catchUp(true),
 m_rxFrequency(0U),
 m_txFrequency(0U),
 m_power(0U),
@@ -129,6 +131,10 @@ bool CConf::read()
 			m_localPort = (unsigned int)::atoi(value);
 		else if (::strcmp(key, "Daemon") == 0)
 			m_daemon = ::atoi(value) == 1;
+		else if (::strcmp(key, "EventLoop") == 0)
+			m_eventLoop = ::atoi(value) == 1;
+		else if (::strcmp(key, "CatchUp") == 0)
+			m_catchUp = ::atoi(value) == 1;
 	} else if (section == SECTION_INFO) {
 		if (::strcmp(key, "TXFrequency") == 0)
 			m_txFrequency = (unsigned int)::atoi(value);
@@ -221,6 +227,16 @@ bool CConf::getDaemon() const
 	return m_daemon;
 }
 
+bool CConf::getEventLoop() const
+{
+	return m_eventLoop;
+}
+
+bool CConf::getCatchUp() const
+{
+	return m_catchUp;
+}
+
 unsigned int CConf::getRxFrequency() const
 {
 	return m_rxFrequency;
@@ -38,6 +38,8 @@ public:
   std::string  getLocalAddress() const;
   unsigned int getLocalPort() const;
   bool         getDaemon() const;
+  bool         getEventLoop() const;
+  bool         getCatchUp() const;
 
   // The Info section
   unsigned int getRxFrequency() const;
@@ -80,6 +82,8 @@ private:
   std::string  m_localAddress;
   unsigned int m_localPort;
   bool         m_daemon;
+  bool         m_eventLoop;
+  bool         m_catchUp;
 
   unsigned int m_rxFrequency;
   unsigned int m_txFrequency;
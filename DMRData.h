@@ -59,7 +59,7 @@ public:
 
 private:
 	unsigned int   m_slotNo;
-	unsigned char* m_data;
+	unsigned char  m_data[2U * DMR_FRAME_LENGTH_BYTES];
 	unsigned int   m_srcId;
 	unsigned int   m_dstId;
 	FLCO           m_flco;
@@ -27,20 +27,16 @@
 #include <cstring>
 
 CDMREmbeddedData::CDMREmbeddedData() :
-m_raw(NULL),
+m_raw(),
 m_state(LCS_NONE),
-m_data(NULL),
+m_data(),
 m_FLCO(FLCO_GROUP),
 m_valid(false)
 {
-	m_raw  = new bool[128U];
-	m_data = new bool[72U];
 }
 
 CDMREmbeddedData::~CDMREmbeddedData()
 {
-	delete[] m_raw;
-	delete[] m_data;
 }
 
 // Add LC data (which may consist of 4 blocks) to the data store
@@ -123,46 +119,36 @@ void CDMREmbeddedData::encodeEmbeddedData()
 	unsigned int crc;
 	CCRC::encodeFiveBit(m_data, crc);
 
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	data[106U] = (crc & 0x01U) == 0x01U;
-	data[90U]  = (crc & 0x02U) == 0x02U;
-	data[74U]  = (crc & 0x04U) == 0x04U;
-	data[58U]  = (crc & 0x08U) == 0x08U;
-	data[42U]  = (crc & 0x10U) == 0x10U;
+	// Eight rows of 16 bits, the first column in the most significant bit
+	unsigned int rows[8U];
 
+	// The first two rows hold 11 bits of data, the next five 10 bits and a bit of the CRC
 	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		data[a] = m_data[b];
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int bits = r < 2U ? 11U : 10U;
+
+		rows[r] = 0U;
+		for (unsigned int a = 0U; a < bits; a++, b++)
+			rows[r] = (rows[r] << 1) | (m_data[b] ? 1U : 0U);
+
+		if (r >= 2U)
+			rows[r] = (rows[r] << 1) | ((crc >> (6U - r)) & 0x01U);
+
+		rows[r] <<= 5;
+	}
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U)
-		CHamming::encode16114(data + a);
+	for (unsigned int r = 0U; r < 7U; r++)
+		CHamming::encode16114(rows[r]);
 
 	// Add the parity bits for each column
-	for (unsigned int a = 0U; a < 16U; a++)
-		data[a + 112U] = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U];
+	rows[7U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U];
 
 	// The data is packed downwards in columns
-	b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		m_raw[a] = data[b];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
+	bool* p = m_raw;
+	for (unsigned int mask = 0x8000U; mask != 0U; mask >>= 1) {
+		for (unsigned int r = 0U; r < 8U; r++)
+			*p++ = (rows[r] & mask) != 0U;
 	}
 }
 
@@ -212,55 +198,38 @@ unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) co
 // Unpack and error check an embedded LC
 void CDMREmbeddedData::decodeEmbeddedData()
 {
-	// The data is unpacked downwards in columns
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
-
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		data[b] = m_raw[a];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
+	// The data is unpacked downwards in columns into eight rows of 16 bits
+	unsigned int rows[8U] = {0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U};
+
+	const bool* p = m_raw;
+	for (unsigned int mask = 0x8000U; mask != 0U; mask >>= 1) {
+		for (unsigned int r = 0U; r < 8U; r++) {
+			if (*p++)
+				rows[r] |= mask;
+		}
 	}
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U) {
-		if (!CHamming::decode16114(data + a))
+	for (unsigned int r = 0U; r < 7U; r++) {
+		if (!CHamming::decode16114(rows[r]))
 			return;
 	}
 
 	// Check the parity bits
-	for (unsigned int a = 0U; a < 16U; a++) {
-		bool parity = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U] ^ data[a + 112U];
-		if (parity)
-			return;
-	}
+	if ((rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U] ^ rows[7U]) != 0U)
+		return;
 
-	// We have passed the Hamming check so extract the actual payload
-	b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		m_data[b] = data[a];
-
-	// Extract the 5 bit CRC
+	// We have passed the Hamming check so extract the actual payload and the 5 bit CRC
 	unsigned int crc = 0U;
-	if (data[42])  crc += 16U;
-	if (data[58])  crc += 8U;
-	if (data[74])  crc += 4U;
-	if (data[90])  crc += 2U;
-	if (data[106]) crc += 1U;
+	unsigned int b = 0U;
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int bits = r < 2U ? 11U : 10U;
+		for (unsigned int a = 0U; a < bits; a++, b++)
+			m_data[b] = ((rows[r] >> (15U - a)) & 0x01U) == 0x01U;
+
+		if (r >= 2U)
+			crc = (crc << 1) | ((rows[r] >> 5) & 0x01U);
+	}
 
 	// Now CRC check this
 	if (!CCRC::checkFiveBit(m_data, crc))
@@ -50,9 +50,9 @@ public:
 	void reset();
 
 private:
-	bool*        m_raw;
+	bool         m_raw[128U];
 	LC_STATE     m_state;
-	bool*        m_data;
+	bool         m_data[72U];
 	FLCO         m_FLCO;
 	bool         m_valid;
 
@@ -0,0 +1,50 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRIdIndex.h"
+#include "DMRIdParser.h"
+
+#include <cstdio>
+
+// Compiles an Id file, DMRIds.dat or a RadioID CSV, into the index that CDMRLookup maps
+int main(int argc, char** argv)
+{
+	if (argc != 3) {
+		::fprintf(stderr, "Usage: DMRIdCompile <Id file> <index file>\n");
+		return 1;
+	}
+
+	std::vector<std::pair<unsigned int, std::string> > entries;
+	if (!CDMRIdParser::read(argv[1], entries))
+		return 1;
+
+	if (entries.empty()) {
+		::fprintf(stderr, "DMRIdCompile: no Ids found in %s\n", argv[1]);
+		return 1;
+	}
+
+	CDMRIdIndex index;
+	index.build(entries);
+
+	if (!index.save(argv[2]))
+		return 1;
+
+	::fprintf(stdout, "Compiled %u Ids from %u lines into %s, %u bytes\n", index.getCount(), (unsigned int)entries.size(), argv[2], (unsigned int)index.getLength());
+
+	return 0;
+}
@@ -0,0 +1,373 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRIdIndex.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+const char INDEX_MAGIC[] = {'D', 'M', 'R', 'I', 'D', 'I', 'D', 'X'};
+
+const uint32_t INDEX_VERSION    = 2U;
+const uint32_t INDEX_BYTE_ORDER = 0x01020304U;
+
+const uint32_t MIN_SLOTS = 16U;
+
+CDMRIdIndex::CDMRIdIndex() :
+m_file(),
+m_data(NULL),
+m_length(0U),
+m_header(NULL),
+m_entries(NULL),
+m_slots(NULL),
+m_pool(NULL)
+{
+}
+
+CDMRIdIndex::~CDMRIdIndex()
+{
+	close();
+}
+
+bool CDMRIdIndex::isIndex(const std::string& filename)
+{
+	FILE* fp = ::fopen(filename.c_str(), "rb");
+	if (fp == NULL)
+		return false;
+
+	char magic[sizeof(INDEX_MAGIC)];
+	bool ret = ::fread(magic, 1U, sizeof(magic), fp) == sizeof(magic) && ::memcmp(magic, INDEX_MAGIC, sizeof(magic)) == 0;
+
+	::fclose(fp);
+
+	return ret;
+}
+
+bool CDMRIdIndex::open(const std::string& filename)
+{
+	close();
+
+	if (!m_file.open(filename)) {
+		LogWarning("Cannot open the Id index file - %s", filename.c_str());
+		return false;
+	}
+
+	m_data   = m_file.getData();
+	m_length = m_file.getLength();
+
+	if (!attach()) {
+		LogWarning("The Id index file is damaged or was built on a different type of host - %s", filename.c_str());
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void CDMRIdIndex::build(const std::vector<std::pair<unsigned int, std::string> >& entries)
+{
+	close();
+
+	const uint32_t n = uint32_t(entries.size());
+
+	// Sorting the positions keeps the file order within equal ids and equal callsigns, the last of each is used
+	std::vector<uint32_t> byId(n);
+	std::vector<uint32_t> byCallsign(n);
+	for (uint32_t i = 0U; i < n; i++)
+		byId[i] = byCallsign[i] = i;
+
+	std::stable_sort(byId.begin(), byId.end(), [&entries](uint32_t a, uint32_t b) { return entries[a].first < entries[b].first; });
+	std::stable_sort(byCallsign.begin(), byCallsign.end(), [&entries](uint32_t a, uint32_t b) { return entries[a].second < entries[b].second; });
+
+	// Each different callsign goes in the pool once, the offset of the callsign of every pair is kept
+	std::vector<uint32_t> offsets(n);
+	uint32_t poolSize  = 1U;
+	uint32_t callsigns = 0U;
+	for (uint32_t i = 0U; i < n; i++) {
+		if (i == 0U || entries[byCallsign[i]].second != entries[byCallsign[i - 1U]].second) {
+			offsets[byCallsign[i]] = poolSize;
+			poolSize += uint32_t(entries[byCallsign[i]].second.length()) + 1U;
+			callsigns++;
+		} else {
+			offsets[byCallsign[i]] = offsets[byCallsign[i - 1U]];
+		}
+	}
+
+	uint32_t count = 0U;
+	for (uint32_t i = 0U; i < n; i++) {
+		if (i + 1U == n || entries[byId[i]].first != entries[byId[i + 1U]].first)
+			count++;
+	}
+
+	// Three quarters full, so that a probe ends quickly
+	uint32_t slotCount = std::max(MIN_SLOTS, uint32_t((uint64_t(callsigns) * 4U) / 3U + 1U));
+
+	m_length = sizeof(CHeader) + count * sizeof(CEntry) + slotCount * sizeof(CSlot) + poolSize;
+
+	unsigned char* data = new unsigned char[m_length];
+	::memset(data, 0x00U, m_length);
+	m_data = data;
+
+	CHeader* header = (CHeader*)data;
+	::memcpy(header->m_magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	header->m_version   = INDEX_VERSION;
+	header->m_byteOrder = INDEX_BYTE_ORDER;
+	header->m_count     = count;
+	header->m_slotCount = slotCount;
+	header->m_poolSize  = poolSize;
+
+	CEntry* entry = (CEntry*)(data + sizeof(CHeader));
+	CSlot*  slots = (CSlot*)(entry + count);
+	char*   pool  = (char*)(slots + slotCount);
+
+	for (uint32_t i = 0U; i < n; i++) {
+		if (i + 1U == n || entries[byId[i]].first != entries[byId[i + 1U]].first) {
+			entry->m_id     = entries[byId[i]].first;
+			entry->m_offset = offsets[byId[i]];
+			entry++;
+		}
+	}
+
+	for (uint32_t i = 0U; i < n; i++) {
+		if (i + 1U < n && entries[byCallsign[i]].second == entries[byCallsign[i + 1U]].second)
+			continue;
+
+		const std::pair<unsigned int, std::string>& last = entries[byCallsign[i]];
+		uint32_t offset = offsets[byCallsign[i]];
+		::memcpy(pool + offset, last.second.c_str(), last.second.length() + 1U);
+
+		uint64_t key = getKey(last.second.c_str());
+		uint32_t pos = getSlot(key, slotCount);
+		while (slots[pos].m_offset != 0U) {
+			if (++pos == slotCount)
+				pos = 0U;
+		}
+
+		slots[pos].m_key    = key;
+		slots[pos].m_id     = last.first;
+		slots[pos].m_offset = offset;
+	}
+
+	bool ret = attach();
+	assert(ret);
+}
+
+bool CDMRIdIndex::save(const std::string& filename) const
+{
+	assert(m_data != NULL);
+
+	std::string temp = filename + ".tmp";
+
+	FILE* fp = ::fopen(temp.c_str(), "wb");
+	if (fp == NULL) {
+		LogError("Cannot create the Id index file - %s", temp.c_str());
+		return false;
+	}
+
+	bool ret = ::fwrite(m_data, 1U, m_length, fp) == m_length;
+	ret = ::fclose(fp) == 0 && ret;
+	if (!ret) {
+		LogError("Cannot write the Id index file - %s", temp.c_str());
+		::remove(temp.c_str());
+		return false;
+	}
+
+	// Renaming leaves the old file in place for anything that still has it mapped
+#if defined(_WIN32) || defined(_WIN64)
+	ret = ::MoveFileExA(temp.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	ret = ::rename(temp.c_str(), filename.c_str()) == 0;
+#endif
+	if (!ret) {
+		LogError("Cannot replace the Id index file - %s", filename.c_str());
+		::remove(temp.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+void CDMRIdIndex::close()
+{
+	if (m_data != m_file.getData())
+		delete[] m_data;
+
+	m_file.close();
+
+	m_data    = NULL;
+	m_length  = 0U;
+	m_header  = NULL;
+	m_entries = NULL;
+	m_slots   = NULL;
+	m_pool    = NULL;
+}
+
+const char* CDMRIdIndex::findCS(unsigned int id) const
+{
+	if (m_header == NULL)
+		return NULL;
+
+	uint32_t n = m_header->m_count;
+	if (n == 0U)
+		return NULL;
+
+	// Halving without a branch on the comparison, which the processor cannot predict
+	const CEntry* entry = m_entries;
+	while (n > 1U) {
+		uint32_t half = n / 2U;
+		entry = (entry[half].m_id < id) ? entry + half : entry;
+		n -= half;
+	}
+
+	if (entry->m_id < id)
+		entry++;
+
+	if (entry == m_entries + m_header->m_count || entry->m_id != id || entry->m_offset >= m_header->m_poolSize)
+		return NULL;
+
+	return getCallsign(entry->m_offset);
+}
+
+bool CDMRIdIndex::findID(const std::string& callsign, unsigned int& id) const
+{
+	if (m_header == NULL)
+		return false;
+
+	uint64_t key = getKey(callsign.c_str());
+
+	// A callsign shorter than the key is all in the key, with its terminator
+	bool inKey = callsign.length() < sizeof(key);
+
+	uint32_t slotCount = m_header->m_slotCount;
+	uint32_t pos = getSlot(key, slotCount);
+	for (uint32_t i = 0U; i < slotCount; i++) {
+		const CSlot& slot = m_slots[pos];
+		if (slot.m_offset == 0U || slot.m_offset >= m_header->m_poolSize)
+			return false;
+
+		if (slot.m_key == key && (inKey || ::strcmp(m_pool + slot.m_offset, callsign.c_str()) == 0)) {
+			id = slot.m_id;
+			return true;
+		}
+
+		if (++pos == slotCount)
+			pos = 0U;
+	}
+
+	return false;
+}
+
+unsigned int CDMRIdIndex::getCount() const
+{
+	return m_header != NULL ? m_header->m_count : 0U;
+}
+
+void CDMRIdIndex::compare(const CDMRIdIndex& previous, unsigned int& added, unsigned int& removed, unsigned int& changed) const
+{
+	added = removed = changed = 0U;
+
+	unsigned int n1 = getCount();
+	unsigned int n2 = previous.getCount();
+
+	// Both are sorted by id, so one pass over each finds the differences
+	unsigned int i1 = 0U;
+	unsigned int i2 = 0U;
+	while (i1 < n1 || i2 < n2) {
+		if (i2 == n2 || (i1 < n1 && m_entries[i1].m_id < previous.m_entries[i2].m_id)) {
+			added++;
+			i1++;
+		} else if (i1 == n1 || previous.m_entries[i2].m_id < m_entries[i1].m_id) {
+			removed++;
+			i2++;
+		} else {
+			if (::strcmp(getCallsign(m_entries[i1].m_offset), previous.getCallsign(previous.m_entries[i2].m_offset)) != 0)
+				changed++;
+			i1++;
+			i2++;
+		}
+	}
+}
+
+bool CDMRIdIndex::isSame(const CDMRIdIndex& other) const
+{
+	return m_length == other.m_length && (m_length == 0U || ::memcmp(m_data, other.m_data, m_length) == 0);
+}
+
+size_t CDMRIdIndex::getLength() const
+{
+	return m_length;
+}
+
+// Checks the header and that the layout fits the data exactly
+bool CDMRIdIndex::attach()
+{
+	if (m_length < sizeof(CHeader))
+		return false;
+
+	const CHeader* header = (const CHeader*)m_data;
+	if (::memcmp(header->m_magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header->m_version != INDEX_VERSION || header->m_byteOrder != INDEX_BYTE_ORDER)
+		return false;
+
+	if (header->m_slotCount < MIN_SLOTS || header->m_poolSize == 0U)
+		return false;
+
+	uint64_t length = sizeof(CHeader) + uint64_t(header->m_count) * sizeof(CEntry) + uint64_t(header->m_slotCount) * sizeof(CSlot) + header->m_poolSize;
+	if (uint64_t(m_length) != length)
+		return false;
+
+	m_header   = header;
+	m_entries  = (const CEntry*)(m_data + sizeof(CHeader));
+	m_slots    = (const CSlot*)(m_entries + header->m_count);
+	m_pool     = (const char*)(m_slots + header->m_slotCount);
+
+	// Every string in the pool must end inside it
+	if (m_pool[header->m_poolSize - 1U] != 0x00) {
+		m_header = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+// The empty string at the start of the pool stands in for an offset outside it
+const char* CDMRIdIndex::getCallsign(uint32_t offset) const
+{
+	return m_pool + (offset < m_header->m_poolSize ? offset : 0U);
+}
+
+uint64_t CDMRIdIndex::getKey(const char* callsign)
+{
+	assert(callsign != NULL);
+
+	uint64_t key = 0U;
+	for (unsigned int i = 0U; i < 8U && callsign[i] != 0x00; i++)
+		key |= uint64_t((unsigned char)callsign[i]) << (8U * i);
+
+	return key;
+}
+
+// Scales the top half of the mixed key to the slot count, so the table can be any size
+uint32_t CDMRIdIndex::getSlot(uint64_t key, uint32_t slotCount)
+{
+	uint64_t hash = (key * 0x9E3779B97F4A7C15ULL) >> 32;
+
+	return uint32_t((hash * slotCount) >> 32);
+}
@@ -0,0 +1,115 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRIDINDEX_H)
+#define	DMRIDINDEX_H
+
+#include "MappedFile.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// A DMR Id table laid out as one block of memory, either mapped from a
+// file written by DMRIdCompile or built from an Id list. The layout, in
+// host byte order, is:
+//
+//   header
+//   entries  count x {id, callsign offset}, sorted by id
+//   slots    slotCount x {first 8 bytes of the callsign, id, callsign offset},
+//            open addressing on the callsign, an offset of 0 is an empty slot
+//   pool     the callsigns, NUL terminated, after an empty one at offset 0
+//
+// A mapped file is never written to, so its pages are shared by every
+// process on the host that maps it.
+class CDMRIdIndex {
+public:
+	CDMRIdIndex();
+	~CDMRIdIndex();
+
+	static bool isIndex(const std::string& filename);
+
+	// Maps a compiled index file, false if it is not one or it does not match this host
+	bool open(const std::string& filename);
+
+	// Lays out the pairs in memory, a later pair for the same id or callsign replaces an earlier one
+	void build(const std::vector<std::pair<unsigned int, std::string> >& entries);
+
+	// Writes the index so that it replaces the file in one step, a mapped copy stays valid
+	bool save(const std::string& filename) const;
+
+	void close();
+
+	// NULL when the id is not known
+	const char* findCS(unsigned int id) const;
+
+	bool findID(const std::string& callsign, unsigned int& id) const;
+
+	unsigned int getCount() const;
+
+	// Counts the ids only in this index, only in the previous one, and in both with a different callsign
+	void compare(const CDMRIdIndex& previous, unsigned int& added, unsigned int& removed, unsigned int& changed) const;
+
+	bool isSame(const CDMRIdIndex& other) const;
+
+	size_t getLength() const;
+
+private:
+	struct CHeader {
+		char     m_magic[8U];
+		uint32_t m_version;
+		uint32_t m_byteOrder;
+		uint32_t m_count;
+		uint32_t m_slotCount;
+		uint32_t m_poolSize;
+		uint32_t m_reserved;
+	};
+
+	struct CEntry {
+		uint32_t m_id;
+		uint32_t m_offset;
+	};
+
+	struct CSlot {
+		uint64_t m_key;
+		uint32_t m_id;
+		uint32_t m_offset;
+	};
+
+	CMappedFile          m_file;
+	const unsigned char* m_data;
+	size_t               m_length;
+	const CHeader*       m_header;
+	const CEntry*        m_entries;
+	const CSlot*         m_slots;
+	const char*          m_pool;
+
+	bool attach();
+
+	const char* getCallsign(uint32_t offset) const;
+
+	static uint64_t getKey(const char* callsign);
+	static uint32_t getSlot(uint64_t key, uint32_t slotCount);
+
+	CDMRIdIndex(const CDMRIdIndex&);
+	CDMRIdIndex& operator=(const CDMRIdIndex&);
+};
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRIdParser.h"
+#include "Log.h"
+
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+
+// Smaller files are not worth starting a thread for
+const size_t MIN_CHUNK_LENGTH = 1048576U;
+
+const unsigned int MAX_THREADS = 16U;
+
+const char UTF8_BOM[] = {'\xEF', '\xBB', '\xBF'};
+
+CDMRIdParser::CDMRIdParser(const char* start, const char* end, bool csv) :
+CThread(),
+m_start(start),
+m_end(end),
+m_csv(csv),
+m_entries()
+{
+}
+
+bool CDMRIdParser::read(const std::string& filename, std::vector<std::pair<unsigned int, std::string> >& entries, unsigned int threads)
+{
+	FILE* fp = ::fopen(filename.c_str(), "rb");
+	if (fp == NULL) {
+		LogWarning("Cannot open the Id lookup file - %s", filename.c_str());
+		return false;
+	}
+
+	// Read rather than mapped, as the file may be rewritten in place while
+	// it is parsed, and reading a mapping past its new end raises SIGBUS
+	std::vector<char> buffer;
+	long size = -1L;
+	if (::fseek(fp, 0L, SEEK_END) == 0)
+		size = ::ftell(fp);
+	if (size < 0L || ::fseek(fp, 0L, SEEK_SET) != 0) {
+		LogWarning("Cannot read the Id lookup file - %s", filename.c_str());
+		::fclose(fp);
+		return false;
+	}
+
+	buffer.resize(size_t(size));
+	buffer.resize(::fread(buffer.data(), 1U, buffer.size(), fp));
+
+	::fclose(fp);
+
+	const char* start = buffer.data();
+	const char* end   = start + buffer.size();
+
+	if (buffer.size() >= sizeof(UTF8_BOM) && ::memcmp(start, UTF8_BOM, sizeof(UTF8_BOM)) == 0)
+		start += sizeof(UTF8_BOM);
+
+	bool csv = isCSV(start, end);
+
+	if (threads == 0U)
+		threads = std::thread::hardware_concurrency();
+	if (threads > MAX_THREADS)
+		threads = MAX_THREADS;
+
+	size_t length = end - start;
+	if (threads > length / MIN_CHUNK_LENGTH)
+		threads = (unsigned int)(length / MIN_CHUNK_LENGTH);
+	if (threads == 0U)
+		threads = 1U;
+
+	// Each chunk ends after the first line end past an even share of the file
+	std::vector<CDMRIdParser*> parsers;
+	const char* p = start;
+	for (unsigned int i = 1U; i <= threads && p < end; i++) {
+		const char* q = end;
+		if (i < threads) {
+			q = start + (length * i) / threads;
+			if (q < p)
+				q = p;
+
+			const char* eol = (const char*)::memchr(q, '\n', end - q);
+			q = (eol != NULL) ? eol + 1 : end;
+		}
+
+		parsers.push_back(new CDMRIdParser(p, q, csv));
+		p = q;
+	}
+
+	// The first chunk is parsed here while the others have a thread each. A
+	// chunk whose thread cannot be started is also parsed here.
+	std::vector<bool> running(parsers.size(), false);
+	for (unsigned int i = 1U; i < parsers.size(); i++) {
+		running[i] = parsers[i]->run();
+		if (!running[i])
+			LogWarning("Cannot start a thread to read part of the Id file, reading it on this one");
+	}
+
+	for (unsigned int i = 0U; i < parsers.size(); i++) {
+		if (!running[i])
+			parsers[i]->parse();
+	}
+
+	size_t count = 0U;
+	for (unsigned int i = 0U; i < parsers.size(); i++) {
+		if (running[i])
+			parsers[i]->wait();
+		count += parsers[i]->m_entries.size();
+	}
+
+	if (entries.empty() && parsers.size() == 1U) {
+		entries.swap(parsers[0U]->m_entries);
+		delete parsers[0U];
+		return true;
+	}
+
+	entries.reserve(entries.size() + count);
+	for (unsigned int i = 0U; i < parsers.size(); i++) {
+		for (std::vector<std::pair<unsigned int, std::string> >::iterator it = parsers[i]->m_entries.begin(); it != parsers[i]->m_entries.end(); ++it)
+			entries.push_back(std::move(*it));
+
+		delete parsers[i];
+	}
+
+	return true;
+}
+
+void CDMRIdParser::entry()
+{
+	parse();
+}
+
+void CDMRIdParser::parse()
+{
+	// Counting the lines first is much cheaper than growing the vector as it fills
+	size_t lines = 0U;
+	for (const char* p = m_start; p < m_end; lines++) {
+		const char* eol = (const char*)::memchr(p, '\n', m_end - p);
+		if (eol == NULL)
+			eol = m_end;
+
+		p = eol + 1;
+	}
+
+	m_entries.reserve(lines);
+
+	const char* p = m_start;
+	while (p < m_end) {
+		const char* eol = (const char*)::memchr(p, '\n', m_end - p);
+		if (eol == NULL)
+			eol = m_end;
+
+		parseLine(p, eol);
+
+		p = eol + 1;
+	}
+}
+
+void CDMRIdParser::parseLine(const char* p, const char* end)
+{
+	if (p == end || *p == '#')
+		return;
+
+	const char* field[2U];
+	const char* fieldEnd[2U];
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		if (m_csv) {
+			// A field ends at the next comma, blanks and quotes around it are dropped
+			const char* comma = (const char*)::memchr(p, ',', end - p);
+			const char* next  = (comma != NULL) ? comma : end;
+
+			while (p < next && (*p == ' ' || *p == '\t' || *p == '"'))
+				p++;
+
+			const char* q = next;
+			while (q > p && (q[-1] == ' ' || q[-1] == '\t' || q[-1] == '\r' || q[-1] == '"'))
+				q--;
+
+			field[i]    = p;
+			fieldEnd[i] = q;
+
+			p = (comma != NULL) ? comma + 1 : end;
+		} else {
+			while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+				p++;
+
+			const char* q = p;
+			while (q < end && *q != ' ' && *q != '\t' && *q != '\r')
+				q++;
+
+			field[i]    = p;
+			fieldEnd[i] = q;
+
+			p = q;
+		}
+
+		if (field[i] == fieldEnd[i])
+			return;
+	}
+
+	if (*field[0U] < '0' || *field[0U] > '9')
+		return;
+
+	unsigned int id = 0U;
+	for (const char* q = field[0U]; q < fieldEnd[0U] && *q >= '0' && *q <= '9'; q++)
+		id = id * 10U + (unsigned int)(*q - '0');
+
+	std::string callsign(field[1U], fieldEnd[1U]);
+	for (std::string::iterator it = callsign.begin(); it != callsign.end(); ++it) {
+		if (*it >= 'a' && *it <= 'z')
+			*it -= 'a' - 'A';
+	}
+
+	m_entries.push_back(std::make_pair(id, callsign));
+}
+
+// The format is set by the first line that is not a comment, CSV when its first field ends at a comma
+bool CDMRIdParser::isCSV(const char* p, const char* end)
+{
+	assert(p != NULL || p == end);
+
+	while (p < end) {
+		if (*p == '#' || *p == '\n' || *p == '\r') {
+			const char* eol = (const char*)::memchr(p, '\n', end - p);
+			if (eol == NULL)
+				return false;
+
+			p = eol + 1;
+			continue;
+		}
+
+		while (p < end && *p != ',' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+			p++;
+
+		return p < end && *p == ',';
+	}
+
+	return false;
+}
@@ -0,0 +1,57 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRIDPARSER_H)
+#define	DMRIDPARSER_H
+
+#include "Thread.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// Reads an Id file into (id, callsign) pairs in file order. The file is
+// either an id and a callsign separated by white space on each line, as in
+// DMRIds.dat, or CSV with the id and the callsign in the first two columns,
+// as in the RadioID user database. Lines whose id is not a number, such as
+// comments and a CSV header, are skipped, and callsigns are upper cased.
+//
+// The file is read into memory and cut at line ends into chunks that are
+// parsed by a thread each.
+class CDMRIdParser : public CThread {
+public:
+	// No threads means one per processor
+	static bool read(const std::string& filename, std::vector<std::pair<unsigned int, std::string> >& entries, unsigned int threads = 0U);
+
+	virtual void entry();
+
+private:
+	const char*                                        m_start;
+	const char*                                        m_end;
+	bool                                               m_csv;
+	std::vector<std::pair<unsigned int, std::string> > m_entries;
+
+	CDMRIdParser(const char* start, const char* end, bool csv);
+
+	void parse();
+	void parseLine(const char* p, const char* end);
+
+	static bool isCSV(const char* p, const char* end);
+};
+
+#endif
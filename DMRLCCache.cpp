@@ -0,0 +1,87 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRLCCache.h"
+#include "DMRSlotType.h"
+#include "DMRFullLC.h"
+#include "DMRLC.h"
+#include "Sync.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+
+CDMRLCCache::CDMRLCCache(unsigned int size) :
+m_size(size),
+m_count(0U),
+m_clock(0U),
+m_entries(NULL)
+{
+	assert(size > 0U);
+
+	m_entries = new CEntry[size];
+}
+
+CDMRLCCache::~CDMRLCCache()
+{
+	delete[] m_entries;
+}
+
+void CDMRLCCache::getData(FLCO flco, unsigned int srcId, unsigned int dstId, unsigned char colorCode, unsigned char dataType, unsigned char* data)
+{
+	assert(data != NULL);
+
+	m_clock++;
+
+	// Small enough for a linear search, and the oldest entry is found on the way
+	CEntry* oldest = NULL;
+	for (unsigned int i = 0U; i < m_count; i++) {
+		CEntry& entry = m_entries[i];
+		if (entry.m_flco == flco && entry.m_srcId == srcId && entry.m_dstId == dstId && entry.m_colorCode == colorCode && entry.m_dataType == dataType) {
+			entry.m_used = m_clock;
+			::memcpy(data, entry.m_data, DMR_FRAME_LENGTH_BYTES);
+			return;
+		}
+
+		if (oldest == NULL || entry.m_used < oldest->m_used)
+			oldest = &entry;
+	}
+
+	// Add sync
+	CSync::addDMRDataSync(data, 0);
+
+	// Add SlotType
+	CDMRSlotType slotType;
+	slotType.setColorCode(colorCode);
+	slotType.setDataType(dataType);
+	slotType.getData(data);
+
+	// Full LC
+	CDMRLC dmrLC(flco, srcId, dstId);
+	CDMRFullLC fullLC;
+	fullLC.encode(dmrLC, data, dataType);
+
+	CEntry* entry = m_count < m_size ? &m_entries[m_count++] : oldest;
+	entry->m_flco      = flco;
+	entry->m_srcId     = srcId;
+	entry->m_dstId     = dstId;
+	entry->m_colorCode = colorCode;
+	entry->m_dataType  = dataType;
+	entry->m_used      = m_clock;
+	::memcpy(entry->m_data, data, DMR_FRAME_LENGTH_BYTES);
+}
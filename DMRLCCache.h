@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRLCCACHE_H)
+#define	DMRLCCACHE_H
+
+#include "DMRDefines.h"
+
+// Keeps the most recently used voice LC header and terminator bursts,
+// fully encoded with sync, slot type and BPTC(196,96) protected full LC,
+// so that a repeat talker does not cost any FEC encoding.
+class CDMRLCCache {
+public:
+	CDMRLCCache(unsigned int size);
+	~CDMRLCCache();
+
+	// Writes the 33 byte burst, encoding it only when it is not cached
+	void getData(FLCO flco, unsigned int srcId, unsigned int dstId, unsigned char colorCode, unsigned char dataType, unsigned char* data);
+
+private:
+	struct CEntry {
+		FLCO          m_flco;
+		unsigned int  m_srcId;
+		unsigned int  m_dstId;
+		unsigned char m_colorCode;
+		unsigned char m_dataType;
+		unsigned int  m_used;
+		unsigned char m_data[DMR_FRAME_LENGTH_BYTES];
+	};
+
+	unsigned int m_size;
+	unsigned int m_count;
+	unsigned int m_clock;
+	CEntry*      m_entries;
+
+	CDMRLCCache(const CDMRLCCache&);
+	CDMRLCCache& operator=(const CDMRLCCache&);
+};
+
+#endif
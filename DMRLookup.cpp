@@ -18,23 +18,39 @@
 */
 
 #include "DMRLookup.h"
+#include "DMRIdParser.h"
+#include "StopWatch.h"
 #include "Timer.h"
 #include "Log.h"
 
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
-#include <cctype>
+#include <cassert>
+
+// How long the file has to be left alone after a change before it is read
+const unsigned int SETTLE_TIME = 2U;
 
 CDMRLookup::CDMRLookup(const std::string& filename, unsigned int reloadTime) :
 CThread(),
 m_filename(filename),
 m_reloadTime(reloadTime),
-m_table(),
-m_cstable(),
-m_mutex(),
-m_stop(false)
+m_snapshot(new CSnapshot),
+m_stop(false),
+m_watch(-1),
+m_watchName(),
+m_mtime(0),
+m_size(0U),
+m_hashed(false)
 {
+	::memset(m_hash, 0x00U, SHA256_DIGEST_SIZE);
 }
 
 CDMRLookup::~CDMRLookup()
@@ -55,19 +71,31 @@ void CDMRLookup::entry()
 {
 	LogInfo("Started the DMR Id lookup reload thread");
 
+	startWatch();
+
 	CTimer timer(1U, 3600U * m_reloadTime);
 	timer.start();
 
+	// Restarted by every change, so a file that is still being written is not read
+	CTimer settle(1U, SETTLE_TIME + 1U);
+
 	while (!m_stop) {
 		sleep(1000U);
 
+		if (hasChanged())
+			settle.start();
+
+		settle.clock();
 		timer.clock();
-		if (timer.hasExpired()) {
+		if (settle.hasExpired() || timer.hasExpired()) {
 			load();
+			settle.stop();
 			timer.start();
 		}
 	}
 
+	stopWatch();
+
 	LogInfo("Stopped the DMR Id lookup reload thread");
 }
 
@@ -85,93 +113,225 @@ void CDMRLookup::stop()
 
 std::string CDMRLookup::findCS(unsigned int id)
 {
-	std::string callsign;
-
 	if (id == 0xFFFFFFU)
 		return std::string("ALL");
 
-	m_mutex.lock();
+	std::shared_ptr<const CSnapshot> snapshot = getSnapshot();
 
-	try {
-		callsign = m_table.at(id);
-	} catch (...) {
-		char text[10U];
-		::sprintf(text, "%u", id);
-		callsign = std::string(text);
-	}
+	const char* callsign = snapshot->m_index.findCS(id);
+	if (callsign != NULL)
+		return std::string(callsign);
 
-	m_mutex.unlock();
+	char text[10U];
+	::sprintf(text, "%u", id);
 
-	return callsign;
+	return std::string(text);
 }
 
 unsigned int CDMRLookup::findID(std::string cs)
 {
-	unsigned int dmrID;
-
-	try {
-		dmrID = m_cstable.at(cs);
-	} catch (...) {
-		dmrID = 0U;
-	}
+	std::shared_ptr<const CSnapshot> snapshot = getSnapshot();
 
-	m_mutex.unlock();
+	unsigned int id;
+	if (snapshot->m_index.findID(cs, id))
+		return id;
 
-	return dmrID;
+	return 0U;
 }
 
 bool CDMRLookup::exists(unsigned int id)
 {
-	m_mutex.lock();
+	std::shared_ptr<const CSnapshot> snapshot = getSnapshot();
 
-	bool found = m_table.count(id) == 1U;
-
-	m_mutex.unlock();
+	return snapshot->m_index.findCS(id) != NULL;
+}
 
-	return found;
+std::shared_ptr<const CDMRLookup::CSnapshot> CDMRLookup::getSnapshot() const
+{
+	return std::atomic_load(&m_snapshot);
 }
 
 bool CDMRLookup::load()
 {
-	FILE* fp = ::fopen(m_filename.c_str(), "rt");
-	if (fp == NULL) {
-		LogWarning("Cannot open the Id lookup file - %s", m_filename.c_str());
+	CStopWatch stopWatch;
+	stopWatch.start();
+
+	// Taken before the file is read, so that a change while it is read is seen next time
+	getFileInfo(m_mtime, m_size);
+
+	// An index is only mapped, which costs less than hashing it, and isSame() finds one that has not changed
+	bool compiled = CDMRIdIndex::isIndex(m_filename);
+
+	unsigned char hash[SHA256_DIGEST_SIZE];
+	if (!compiled) {
+		if (!hashFile(hash)) {
+			LogWarning("Cannot open the Id lookup file - %s", m_filename.c_str());
+			return false;
+		}
+
+		if (m_hashed && ::memcmp(hash, m_hash, SHA256_DIGEST_SIZE) == 0) {
+			LogDebug("The Id lookup file has not changed - %s", m_filename.c_str());
+			return true;
+		}
+	}
+
+	// Built without any lock, nothing else can see it yet
+	std::shared_ptr<CSnapshot> snapshot(new CSnapshot);
+
+	if (compiled) {
+		if (!snapshot->m_index.open(m_filename))
+			return false;
+
+		snapshot->m_compiled = true;
+	} else {
+		std::vector<std::pair<unsigned int, std::string> > entries;
+		if (!CDMRIdParser::read(m_filename, entries))
+			return false;
+
+		snapshot->m_index.build(entries);
+	}
+
+	unsigned int size = snapshot->m_index.getCount();
+
+	if (size == 0U) {
+		LogWarning("No Ids found in the lookup file - %s, keeping the current table", m_filename.c_str());
 		return false;
 	}
 
-	m_mutex.lock();
+	if (!compiled)
+		::memcpy(m_hash, hash, SHA256_DIGEST_SIZE);
+	m_hashed = !compiled;
+
+	// Only the reload thread replaces the snapshot, so this is the one the new one replaces
+	std::shared_ptr<const CSnapshot> current = getSnapshot();
+	if (current->m_index.getCount() == 0U) {
+		std::shared_ptr<const CSnapshot> published = snapshot;
+		std::atomic_store(&m_snapshot, published);
+
+		LogInfo("Loaded %u Ids to the callsign lookup table%s", size, snapshot->m_compiled ? " from the compiled index" : "");
+		return true;
+	}
+
+	if (snapshot->m_index.isSame(current->m_index)) {
+		LogInfo("Reloaded the Id lookup file in %u ms, the %u Ids are unchanged", stopWatch.elapsed(), size);
+		return true;
+	}
 
-	// Remove the old entries
-	m_table.clear();
-	m_cstable.clear();
+	unsigned int added, removed, changed;
+	snapshot->m_index.compare(current->m_index, added, removed, changed);
 
-	char buffer[100U];
-	while (::fgets(buffer, 100U, fp) != NULL) {
-		if (buffer[0U] == '#')
-			continue;
+	std::shared_ptr<const CSnapshot> published = snapshot;
+	std::atomic_store(&m_snapshot, published);
 
-		char* p1 = ::strtok(buffer, " \t\r\n");
-		char* p2 = ::strtok(NULL, " \t\r\n");
+	LogInfo("Reloaded %u Ids to the callsign lookup table%s in %u ms, %u added, %u removed, %u changed", size, snapshot->m_compiled ? " from the compiled index" : "", stopWatch.elapsed(), added, removed, changed);
 
-		if (p1 != NULL && p2 != NULL) {
-			unsigned int id = (unsigned int)::atoi(p1);
-			for (char* p = p2; *p != 0x00U; p++)
-				*p = ::toupper(*p);
+	return true;
+}
+
+void CDMRLookup::startWatch()
+{
+#if defined(__linux__)
+	// The directory is watched, a file replaced by a rename is a new file
+	std::string directory = ".";
+	m_watchName = m_filename;
+
+	std::string::size_type pos = m_filename.find_last_of('/');
+	if (pos != std::string::npos) {
+		directory   = pos > 0U ? m_filename.substr(0U, pos) : "/";
+		m_watchName = m_filename.substr(pos + 1U);
+	}
 
-			m_table[id] = std::string(p2);
-			m_cstable[p2] = id;
+	m_watch = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_watch < 0) {
+		LogWarning("Cannot watch the Id lookup file, checking its time and size instead");
+		return;
+	}
+
+	if (::inotify_add_watch(m_watch, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		LogWarning("Cannot watch %s for the Id lookup file, checking its time and size instead", directory.c_str());
+		::close(m_watch);
+		m_watch = -1;
+	}
+#endif
+}
+
+void CDMRLookup::stopWatch()
+{
+#if defined(__linux__)
+	if (m_watch >= 0)
+		::close(m_watch);
+#endif
+
+	m_watch = -1;
+}
+
+bool CDMRLookup::hasChanged()
+{
+#if defined(__linux__)
+	if (m_watch >= 0) {
+		bool changed = false;
+
+		char buffer[4096U] __attribute__((aligned(__alignof__(struct inotify_event))));
+		ssize_t len;
+		while ((len = ::read(m_watch, buffer, sizeof(buffer))) > 0) {
+			for (char* p = buffer; p < buffer + len; ) {
+				const struct inotify_event* event = (const struct inotify_event*)p;
+
+				if ((event->mask & IN_Q_OVERFLOW) != 0U || (event->len > 0U && m_watchName == event->name))
+					changed = true;
+
+				p += sizeof(struct inotify_event) + event->len;
+			}
 		}
+
+		return changed;
 	}
+#endif
 
-	m_mutex.unlock();
+	time_t mtime;
+	unsigned long long size;
+	if (!getFileInfo(mtime, size))
+		return false;
 
-	::fclose(fp);
+	if (mtime == m_mtime && size == m_size)
+		return false;
 
-	size_t size = m_table.size();
-	if (size == 0U)
+	m_mtime = mtime;
+	m_size  = size;
+
+	return true;
+}
+
+bool CDMRLookup::getFileInfo(time_t& mtime, unsigned long long& size) const
+{
+	struct stat st;
+	if (::stat(m_filename.c_str(), &st) != 0)
+		return false;
+
+	mtime = st.st_mtime;
+	size  = (unsigned long long)st.st_size;
+
+	return true;
+}
+
+bool CDMRLookup::hashFile(unsigned char* hash) const
+{
+	assert(hash != NULL);
+
+	FILE* fp = ::fopen(m_filename.c_str(), "rb");
+	if (fp == NULL)
 		return false;
 
-	LogInfo("Loaded %u Ids to the callsign lookup table", size);
+	CSHA256 sha256;
+
+	unsigned char buffer[65536U];
+	size_t len;
+	while ((len = ::fread(buffer, 1U, sizeof(buffer), fp)) > 0U)
+		sha256.processBytes(buffer, (unsigned int)len);
+
+	::fclose(fp);
+
+	sha256.finish(hash);
 
 	return true;
-}
\ No newline at end of file
+}
@@ -20,12 +20,26 @@
 #ifndef	DMRLookup_H
 #define	DMRLookup_H
 
+#include "DMRIdIndex.h"
+#include "SHA256.h"
 #include "Thread.h"
-#include "Mutex.h"
 
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <ctime>
 
+// Lookups are served from an immutable snapshot of the Id file. A reload
+// builds a complete new snapshot on the reload thread and then swaps the
+// pointer, so a lookup never waits for the file to be parsed, and one that
+// is running during the swap finishes on the snapshot it started with.
+// The file is either a plain Id list, which is laid out in memory the same
+// way as a compiled index, or an index from DMRIdCompile, which is mapped
+// rather than read.
+//
+// The reload thread watches the file, with inotify where there is one and
+// its time and size elsewhere, and also looks at it every reloadTime hours.
+// A plain file whose contents hash the same as the loaded one is not read
+// again, and a new snapshot is only published when its Ids have changed.
 class CDMRLookup : public CThread {
 public:
 	CDMRLookup(const std::string& filename, unsigned int reloadTime);
@@ -43,14 +57,35 @@ public:
 	void stop();
 
 private:
-	std::string                                   m_filename;
-	unsigned int                                  m_reloadTime;
-	std::unordered_map<unsigned int, std::string> m_table;
-	std::unordered_map<std::string, unsigned int> m_cstable;
-	CMutex                                        m_mutex;
-	bool                                          m_stop;
+	struct CSnapshot {
+		bool        m_compiled;
+		CDMRIdIndex m_index;
+
+		CSnapshot() : m_compiled(false), m_index() {}
+	};
+
+	std::string                      m_filename;
+	unsigned int                     m_reloadTime;
+	std::shared_ptr<const CSnapshot> m_snapshot;
+	bool                             m_stop;
+	int                              m_watch;
+	std::string                      m_watchName;
+	time_t                           m_mtime;
+	unsigned long long               m_size;
+	unsigned char                    m_hash[SHA256_DIGEST_SIZE];
+	bool                             m_hashed;
 
 	bool load();
+
+	void startWatch();
+	void stopWatch();
+	bool hasChanged();
+
+	bool getFileInfo(time_t& mtime, unsigned long long& size) const;
+	bool hashFile(unsigned char* hash) const;
+
+	// m_snapshot is only read and replaced with the atomic shared_ptr operations
+	std::shared_ptr<const CSnapshot> getSnapshot() const;
 };
 
 #endif
@@ -485,6 +485,16 @@ void CDMRNetwork::reset(unsigned int slotNo)
 	}
 }
 
+bool CDMRNetwork::hasData()
+{
+	return m_delayBuffers[1U]->hasData() || m_delayBuffers[2U]->hasData();
+}
+
+int CDMRNetwork::getFd() const
+{
+	return m_socket.getFd();
+}
+
 void CDMRNetwork::receiveData(const unsigned char* data, unsigned int length)
 {
 	assert(data != NULL);
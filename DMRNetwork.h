@@ -56,6 +56,10 @@ public:
 
 	void reset(unsigned int slotNo);
 
+	bool hasData();
+
+	int  getFd() const;
+
 	void close();
 
 private: 
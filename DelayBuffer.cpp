@@ -125,6 +125,12 @@ void CDelayBuffer::reset()
 	m_running = false;
 }
 
+bool CDelayBuffer::hasData()
+{
+	// Runs from the first frame appended until the stream is reset
+	return m_timer.isRunning();
+}
+
 void CDelayBuffer::clock(unsigned int ms)
 {
 	m_timer.clock(ms);
@@ -37,6 +37,8 @@ public:
 
 	void reset();
 
+	bool hasData();
+
 	void clock(unsigned int ms);
 
 private:
@@ -0,0 +1,198 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "EventLoop.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdint.h>
+
+CEventLoop::CEventLoop() :
+m_fd(-1)
+{
+	for (unsigned int i = 0U; i < EVENT_MAX_SOURCES; i++) {
+		m_sockets[i]  = -1;
+		m_timers[i]   = -1;
+		m_timeouts[i] = 0U;
+	}
+}
+
+CEventLoop::~CEventLoop()
+{
+	close();
+}
+
+bool CEventLoop::open()
+{
+	m_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	if (m_fd < 0) {
+		LogError("Cannot create the epoll instance, err: %d", errno);
+		return false;
+	}
+
+	return true;
+}
+
+void CEventLoop::setSocket(unsigned int id, int fd)
+{
+	assert(id < EVENT_MAX_SOURCES);
+
+	if (m_fd < 0 || m_sockets[id] == fd)
+		return;
+
+	// The kernel drops closed descriptors from the set by itself
+	if (m_sockets[id] >= 0)
+		::epoll_ctl(m_fd, EPOLL_CTL_DEL, m_sockets[id], NULL);
+
+	m_sockets[id] = fd;
+
+	if (fd < 0)
+		return;
+
+	struct epoll_event ev;
+	::memset(&ev, 0x00, sizeof(struct epoll_event));
+	ev.events   = EPOLLIN;
+	ev.data.u32 = id;
+
+	if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		LogError("Cannot add a socket to the epoll set, err: %d", errno);
+		m_sockets[id] = -1;
+	}
+}
+
+void CEventLoop::setTimer(unsigned int id, unsigned int ms)
+{
+	assert(id < EVENT_MAX_SOURCES);
+
+	if (m_fd < 0 || m_timeouts[id] == ms)
+		return;
+
+	if (m_timers[id] < 0) {
+		m_timers[id] = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (m_timers[id] < 0) {
+			LogError("Cannot create a timerfd, err: %d", errno);
+			return;
+		}
+
+		struct epoll_event ev;
+		::memset(&ev, 0x00, sizeof(struct epoll_event));
+		ev.events   = EPOLLIN;
+		ev.data.u32 = id;
+
+		::epoll_ctl(m_fd, EPOLL_CTL_ADD, m_timers[id], &ev);
+	}
+
+	struct itimerspec its;
+	::memset(&its, 0x00, sizeof(struct itimerspec));
+	its.it_value.tv_sec  = ms / 1000U;
+	its.it_value.tv_nsec = (ms % 1000U) * 1000000L;
+
+	::timerfd_settime(m_timers[id], 0, &its, NULL);
+
+	m_timeouts[id] = ms;
+}
+
+unsigned int CEventLoop::wait()
+{
+	if (m_fd < 0)
+		return 0U;
+
+	struct epoll_event events[EVENT_MAX_SOURCES * 2U];
+
+	int n = ::epoll_wait(m_fd, events, EVENT_MAX_SOURCES * 2U, -1);
+	if (n < 0) {
+		if (errno != EINTR)
+			LogError("Error returned from epoll_wait, err: %d", errno);
+		return 0U;
+	}
+
+	unsigned int mask = 0U;
+	for (int i = 0; i < n; i++) {
+		unsigned int id = events[i].data.u32;
+		mask |= 1U << id;
+
+		if (m_timers[id] >= 0) {
+			uint64_t expirations;
+			if (::read(m_timers[id], &expirations, sizeof(uint64_t)) == sizeof(uint64_t))
+				m_timeouts[id] = 0U;
+		}
+	}
+
+	return mask;
+}
+
+void CEventLoop::close()
+{
+	for (unsigned int i = 0U; i < EVENT_MAX_SOURCES; i++) {
+		if (m_timers[i] >= 0)
+			::close(m_timers[i]);
+
+		m_sockets[i]  = -1;
+		m_timers[i]   = -1;
+		m_timeouts[i] = 0U;
+	}
+
+	if (m_fd >= 0) {
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+#else
+
+CEventLoop::CEventLoop() :
+m_fd(-1)
+{
+}
+
+CEventLoop::~CEventLoop()
+{
+}
+
+bool CEventLoop::open()
+{
+	return false;
+}
+
+void CEventLoop::setSocket(unsigned int, int)
+{
+}
+
+void CEventLoop::setTimer(unsigned int, unsigned int)
+{
+}
+
+unsigned int CEventLoop::wait()
+{
+	return 0U;
+}
+
+void CEventLoop::close()
+{
+}
+
+#endif
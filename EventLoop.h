@@ -0,0 +1,52 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(EVENTLOOP_H)
+#define	EVENTLOOP_H
+
+const unsigned int EVENT_MAX_SOURCES = 8U;
+
+// Blocks until one of the registered sockets is readable or one of the
+// one-shot timers expires. Only available on Linux (epoll and timerfd),
+// open() returns false elsewhere so callers can fall back to polling.
+class CEventLoop {
+public:
+	CEventLoop();
+	~CEventLoop();
+
+	bool open();
+
+	// Watch a socket, an fd of -1 removes it
+	void setSocket(unsigned int id, int fd);
+
+	// Arm a one-shot timer, a timeout of zero disarms it
+	void setTimer(unsigned int id, unsigned int ms);
+
+	// Returns a bit mask of the ids that are ready
+	unsigned int wait();
+
+	void close();
+
+private:
+	int          m_fd;
+	int          m_sockets[EVENT_MAX_SOURCES];
+	int          m_timers[EVENT_MAX_SOURCES];
+	unsigned int m_timeouts[EVENT_MAX_SOURCES];
+};
+
+#endif
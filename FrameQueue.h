@@ -0,0 +1,124 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(FRAMEQUEUE_H)
+#define	FRAMEQUEUE_H
+
+#include "Log.h"
+
+#include <cassert>
+#include <cstring>
+
+// Queue of whole voice frames, each one a tag, LENGTH bytes of payload and
+// the time it was queued. Frames are read in place with peek() and released
+// with pop(), so a group of frames can be consumed in one go.
+template<unsigned int LENGTH> class CFrameQueue {
+public:
+	struct CFrame {
+		unsigned char m_tag;
+		unsigned char m_data[LENGTH];
+		unsigned int  m_time;
+	};
+
+	CFrameQueue(unsigned int size, const char* name) :
+	m_size(1U),
+	m_mask(0U),
+	m_name(name),
+	m_frames(NULL),
+	m_iPtr(0U),
+	m_oPtr(0U)
+	{
+		assert(size > 0U);
+		assert(name != NULL);
+
+		while (m_size < size)
+			m_size <<= 1;
+		m_mask = m_size - 1U;
+
+		m_frames = new CFrame[m_size];
+	}
+
+	~CFrameQueue()
+	{
+		delete[] m_frames;
+	}
+
+	bool push(unsigned char tag, const unsigned char* data, unsigned int time)
+	{
+		assert(data != NULL);
+
+		if (size() == m_size) {
+			LogError("%s frame queue overflow, clearing the queue", m_name);
+			clear();
+			return false;
+		}
+
+		CFrame& frame = m_frames[m_iPtr & m_mask];
+		frame.m_tag  = tag;
+		frame.m_time = time;
+		::memcpy(frame.m_data, data, LENGTH);
+
+		m_iPtr++;
+
+		return true;
+	}
+
+	// The n'th oldest frame, which must exist
+	const CFrame& peek(unsigned int n = 0U) const
+	{
+		assert(n < size());
+
+		return m_frames[(m_oPtr + n) & m_mask];
+	}
+
+	void pop(unsigned int n = 1U)
+	{
+		assert(n <= size());
+
+		m_oPtr += n;
+	}
+
+	void clear()
+	{
+		m_iPtr = 0U;
+		m_oPtr = 0U;
+	}
+
+	unsigned int size() const
+	{
+		return m_iPtr - m_oPtr;
+	}
+
+	bool isEmpty() const
+	{
+		return m_iPtr == m_oPtr;
+	}
+
+private:
+	unsigned int m_size;
+	unsigned int m_mask;
+	const char*  m_name;
+	CFrame*      m_frames;
+	unsigned int m_iPtr;
+	unsigned int m_oPtr;
+
+	CFrameQueue(const CFrameQueue&);
+	CFrameQueue& operator=(const CFrameQueue&);
+};
+
+#endif
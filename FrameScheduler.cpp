@@ -0,0 +1,176 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "FrameScheduler.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cassert>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <time.h>
+#endif
+
+// A frame sent this many microseconds after its deadline counts as late
+const unsigned long long LATE_THRESHOLD = 1000ULL;
+
+// Falling further behind than this many slots restarts the grid when catching up
+const unsigned long long MAX_CATCHUP = 4ULL;
+
+CFrameScheduler::CFrameScheduler(const std::string& name, unsigned int period, bool catchUp) :
+m_name(name),
+m_period(period * 1000ULL),
+m_catchUp(catchUp),
+m_running(false),
+m_starved(false),
+m_deadline(0ULL),
+m_frames(0U),
+m_late(0U),
+m_skipped(0U),
+m_underruns(0U),
+m_resyncs(0U),
+m_jitterSum(0ULL),
+m_jitterMax(0ULL)
+{
+	assert(period > 0U);
+
+#if defined(_WIN32) || defined(_WIN64)
+	::QueryPerformanceFrequency(&m_frequency);
+#endif
+}
+
+CFrameScheduler::~CFrameScheduler()
+{
+}
+
+void CFrameScheduler::start()
+{
+	if (m_running)
+		stop();
+
+	m_starved   = false;
+	m_deadline  = now();
+	m_frames    = 0U;
+	m_late      = 0U;
+	m_skipped   = 0U;
+	m_underruns = 0U;
+	m_resyncs   = 0U;
+	m_jitterSum = 0ULL;
+	m_jitterMax = 0ULL;
+
+	m_running = true;
+}
+
+bool CFrameScheduler::isDue()
+{
+	if (!m_running)
+		return true;
+
+	return now() >= m_deadline;
+}
+
+unsigned int CFrameScheduler::getRemaining()
+{
+	if (!m_running)
+		return 0U;
+
+	unsigned long long t = now();
+	if (t >= m_deadline)
+		return 0U;
+
+	return (unsigned int)((m_deadline - t + 999ULL) / 1000ULL);
+}
+
+void CFrameScheduler::sent()
+{
+	if (!m_running)
+		start();
+
+	unsigned long long t = now();
+
+	// The source was late, not us
+	if (m_starved) {
+		m_deadline = t;
+		m_starved  = false;
+	}
+
+	unsigned long long jitter = t > m_deadline ? t - m_deadline : 0ULL;
+	m_jitterSum += jitter;
+	if (jitter > m_jitterMax)
+		m_jitterMax = jitter;
+	if (jitter >= LATE_THRESHOLD)
+		m_late++;
+	m_frames++;
+
+	m_deadline += m_period;
+
+	// Already past the next deadline as well?
+	if (t >= m_deadline) {
+		unsigned long long missed = (t - m_deadline) / m_period + 1ULL;
+
+		if (!m_catchUp) {
+			m_deadline += missed * m_period;
+			m_skipped  += (unsigned int)missed;
+		} else if (missed > MAX_CATCHUP) {
+			m_deadline = t + m_period;
+			m_resyncs++;
+		}
+	}
+}
+
+void CFrameScheduler::underrun()
+{
+	if (!m_running || m_starved)
+		return;
+
+	m_starved = true;
+	m_underruns++;
+}
+
+void CFrameScheduler::stop()
+{
+	if (!m_running)
+		return;
+
+	m_running = false;
+
+	if (m_frames == 0U)
+		return;
+
+	LogMessage("%s frame timing: %u frames, jitter avg %.1fms max %.1fms, %u late, %u skipped, %u underruns, %u resyncs", m_name.c_str(), m_frames,
+		float(m_jitterSum) / float(m_frames) / 1000.0F, float(m_jitterMax) / 1000.0F, m_late, m_skipped, m_underruns, m_resyncs);
+}
+
+unsigned long long CFrameScheduler::now()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	LARGE_INTEGER count;
+	::QueryPerformanceCounter(&count);
+
+	// Scaling the whole count would overflow after about ten days at 10MHz
+	long long secs = count.QuadPart / m_frequency.QuadPart;
+	long long rest = count.QuadPart % m_frequency.QuadPart;
+
+	return (unsigned long long)(secs * 1000000LL + rest * 1000000LL / m_frequency.QuadPart);
+#else
+	struct timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000ULL;
+#endif
+}
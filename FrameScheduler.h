@@ -0,0 +1,76 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(FRAMESCHEDULER_H)
+#define	FRAMESCHEDULER_H
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#endif
+
+#include <string>
+
+// Emits frames on an absolute grid of deadlines so that the cadence does
+// not drift with the loop timing. A frame that goes out late is either
+// followed by the next one straight away (catch up) or the missed slots
+// are dropped from the grid (skip). Running out of frames to send is not
+// lateness, the grid restarts from the next frame that becomes available.
+class CFrameScheduler {
+public:
+	CFrameScheduler(const std::string& name, unsigned int period, bool catchUp);
+	~CFrameScheduler();
+
+	// Anchors the grid at the current time and clears the statistics
+	void start();
+
+	bool isDue();
+
+	// Milliseconds until the next deadline, zero if it has passed
+	unsigned int getRemaining();
+
+	// Records the jitter of the frame just sent and moves to the next slot
+	void sent();
+
+	// A frame was due but there was nothing to send
+	void underrun();
+
+	// Logs the statistics of the call
+	void stop();
+
+private:
+	std::string        m_name;
+	unsigned long long m_period;
+	bool               m_catchUp;
+	bool               m_running;
+	bool               m_starved;
+	unsigned long long m_deadline;
+	unsigned int       m_frames;
+	unsigned int       m_late;
+	unsigned int       m_skipped;
+	unsigned int       m_underruns;
+	unsigned int       m_resyncs;
+	unsigned long long m_jitterSum;
+	unsigned long long m_jitterMax;
+#if defined(_WIN32) || defined(_WIN64)
+	LARGE_INTEGER      m_frequency;
+#endif
+
+	unsigned long long now();
+};
+
+#endif
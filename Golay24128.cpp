@@ -1039,34 +1039,81 @@ static const unsigned int DECODING_TABLE_23127[] = {
 	0x403000U, 0x080840U, 0x100044U, 0x011008U, 0x022800U, 0x004110U, 0x100040U, 0x100041U, 0x100042U, 0x440020U, 
 	0x011001U, 0x011000U, 0x080420U, 0x011002U, 0x100048U, 0x011004U, 0x204200U, 0x028080U};
 
-#define X22             0x00400000   /* vector representation of X^{22} */
-#define X11             0x00000800   /* vector representation of X^{11} */
-#define MASK12          0xfffff800   /* auxiliary vector for testing */
-#define GENPOL          0x00000c75   /* generator polinomial, g(x) */
+static const unsigned int SYNDROME_TABLE_23127_HIGH[] = {
+	0x000U, 0x366U, 0x6CCU, 0x5AAU, 0x1EDU, 0x28BU, 0x721U, 0x447U,
+	0x3DAU, 0x0BCU, 0x516U, 0x670U, 0x237U, 0x151U, 0x4FBU, 0x79DU,
+	0x7B4U, 0x4D2U, 0x178U, 0x21EU, 0x659U, 0x53FU, 0x095U, 0x3F3U,
+	0x46EU, 0x708U, 0x2A2U, 0x1C4U, 0x583U, 0x6E5U, 0x34FU, 0x029U,
+	0x31DU, 0x07BU, 0x5D1U, 0x6B7U, 0x2F0U, 0x196U, 0x43CU, 0x75AU,
+	0x0C7U, 0x3A1U, 0x60BU, 0x56DU, 0x12AU, 0x24CU, 0x7E6U, 0x480U,
+	0x4A9U, 0x7CFU, 0x265U, 0x103U, 0x544U, 0x622U, 0x388U, 0x0EEU,
+	0x773U, 0x415U, 0x1BFU, 0x2D9U, 0x69EU, 0x5F8U, 0x052U, 0x334U,
+	0x63AU, 0x55CU, 0x0F6U, 0x390U, 0x7D7U, 0x4B1U, 0x11BU, 0x27DU,
+	0x5E0U, 0x686U, 0x32CU, 0x04AU, 0x40DU, 0x76BU, 0x2C1U, 0x1A7U,
+	0x18EU, 0x2E8U, 0x742U, 0x424U, 0x063U, 0x305U, 0x6AFU, 0x5C9U,
+	0x254U, 0x132U, 0x498U, 0x7FEU, 0x3B9U, 0x0DFU, 0x575U, 0x613U,
+	0x527U, 0x641U, 0x3EBU, 0x08DU, 0x4CAU, 0x7ACU, 0x206U, 0x160U,
+	0x6FDU, 0x59BU, 0x031U, 0x357U, 0x710U, 0x476U, 0x1DCU, 0x2BAU,
+	0x293U, 0x1F5U, 0x45FU, 0x739U, 0x37EU, 0x018U, 0x5B2U, 0x6D4U,
+	0x149U, 0x22FU, 0x785U, 0x4E3U, 0x0A4U, 0x3C2U, 0x668U, 0x50EU};
+
+static const unsigned int SYNDROME_TABLE_23127_MID[] = {
+	0x000U, 0x100U, 0x200U, 0x300U, 0x400U, 0x500U, 0x600U, 0x700U,
+	0x475U, 0x575U, 0x675U, 0x775U, 0x075U, 0x175U, 0x275U, 0x375U,
+	0x49FU, 0x59FU, 0x69FU, 0x79FU, 0x09FU, 0x19FU, 0x29FU, 0x39FU,
+	0x0EAU, 0x1EAU, 0x2EAU, 0x3EAU, 0x4EAU, 0x5EAU, 0x6EAU, 0x7EAU,
+	0x54BU, 0x44BU, 0x74BU, 0x64BU, 0x14BU, 0x04BU, 0x34BU, 0x24BU,
+	0x13EU, 0x03EU, 0x33EU, 0x23EU, 0x53EU, 0x43EU, 0x73EU, 0x63EU,
+	0x1D4U, 0x0D4U, 0x3D4U, 0x2D4U, 0x5D4U, 0x4D4U, 0x7D4U, 0x6D4U,
+	0x5A1U, 0x4A1U, 0x7A1U, 0x6A1U, 0x1A1U, 0x0A1U, 0x3A1U, 0x2A1U,
+	0x6E3U, 0x7E3U, 0x4E3U, 0x5E3U, 0x2E3U, 0x3E3U, 0x0E3U, 0x1E3U,
+	0x296U, 0x396U, 0x096U, 0x196U, 0x696U, 0x796U, 0x496U, 0x596U,
+	0x27CU, 0x37CU, 0x07CU, 0x17CU, 0x67CU, 0x77CU, 0x47CU, 0x57CU,
+	0x609U, 0x709U, 0x409U, 0x509U, 0x209U, 0x309U, 0x009U, 0x109U,
+	0x3A8U, 0x2A8U, 0x1A8U, 0x0A8U, 0x7A8U, 0x6A8U, 0x5A8U, 0x4A8U,
+	0x7DDU, 0x6DDU, 0x5DDU, 0x4DDU, 0x3DDU, 0x2DDU, 0x1DDU, 0x0DDU,
+	0x737U, 0x637U, 0x537U, 0x437U, 0x337U, 0x237U, 0x137U, 0x037U,
+	0x342U, 0x242U, 0x142U, 0x042U, 0x742U, 0x642U, 0x542U, 0x442U,
+	0x1B3U, 0x0B3U, 0x3B3U, 0x2B3U, 0x5B3U, 0x4B3U, 0x7B3U, 0x6B3U,
+	0x5C6U, 0x4C6U, 0x7C6U, 0x6C6U, 0x1C6U, 0x0C6U, 0x3C6U, 0x2C6U,
+	0x52CU, 0x42CU, 0x72CU, 0x62CU, 0x12CU, 0x02CU, 0x32CU, 0x22CU,
+	0x159U, 0x059U, 0x359U, 0x259U, 0x559U, 0x459U, 0x759U, 0x659U,
+	0x4F8U, 0x5F8U, 0x6F8U, 0x7F8U, 0x0F8U, 0x1F8U, 0x2F8U, 0x3F8U,
+	0x08DU, 0x18DU, 0x28DU, 0x38DU, 0x48DU, 0x58DU, 0x68DU, 0x78DU,
+	0x067U, 0x167U, 0x267U, 0x367U, 0x467U, 0x567U, 0x667U, 0x767U,
+	0x412U, 0x512U, 0x612U, 0x712U, 0x012U, 0x112U, 0x212U, 0x312U,
+	0x750U, 0x650U, 0x550U, 0x450U, 0x350U, 0x250U, 0x150U, 0x050U,
+	0x325U, 0x225U, 0x125U, 0x025U, 0x725U, 0x625U, 0x525U, 0x425U,
+	0x3CFU, 0x2CFU, 0x1CFU, 0x0CFU, 0x7CFU, 0x6CFU, 0x5CFU, 0x4CFU,
+	0x7BAU, 0x6BAU, 0x5BAU, 0x4BAU, 0x3BAU, 0x2BAU, 0x1BAU, 0x0BAU,
+	0x21BU, 0x31BU, 0x01BU, 0x11BU, 0x61BU, 0x71BU, 0x41BU, 0x51BU,
+	0x66EU, 0x76EU, 0x46EU, 0x56EU, 0x26EU, 0x36EU, 0x06EU, 0x16EU,
+	0x684U, 0x784U, 0x484U, 0x584U, 0x284U, 0x384U, 0x084U, 0x184U,
+	0x2F1U, 0x3F1U, 0x0F1U, 0x1F1U, 0x6F1U, 0x7F1U, 0x4F1U, 0x5F1U};
 
 static unsigned int get_syndrome_23127(unsigned int pattern)
 /*
  * Compute the syndrome corresponding to the given pattern, i.e., the
  * remainder after dividing the pattern (when considering it as the vector
- * representation of a polynomial) by the generator polynomial, GENPOL.
- * In the program this pattern has several meanings: (1) pattern = infomation
- * bits, when constructing the encoding table; (2) pattern = error pattern,
- * when constructing the decoding table; and (3) pattern = received vector, to
- * obtain its syndrome in decoding.
+ * representation of a polynomial) by the generator polynomial, g(x) = 0xC75.
+ * The remainder is linear in the pattern, so it is the XOR of the remainders
+ * of its top 7 bits and middle 8 bits, taken from the tables above, and of
+ * the low 8 bits, which are already below the degree of g(x).
  */
 {
-	unsigned int aux = X22;
- 
-	if (pattern >= X11) {
-		while (pattern & MASK12) {
-			while (!(aux & pattern))
-				aux = aux >> 1;
+	return SYNDROME_TABLE_23127_HIGH[(pattern >> 16) & 0x7FU] ^
+		   SYNDROME_TABLE_23127_MID[(pattern >> 8) & 0xFFU] ^
+		   (pattern & 0xFFU);
+}
 
-			pattern ^= (aux / X11) * GENPOL;
-		}
-	}
+static unsigned int count_bits(unsigned int pattern)
+{
+	unsigned int count = 0U;
+
+	for (; pattern != 0U; count++)
+		pattern &= pattern - 1U;
 
-	return pattern;
+	return count;
 }
 
 unsigned int CGolay24128::encode23127(unsigned int data)
@@ -1089,11 +1136,49 @@ unsigned int CGolay24128::decode23127(unsigned int code)
 	return code >> 11;
 }
 
+unsigned int CGolay24128::decode23127(unsigned int code, unsigned int& errors)
+{
+	unsigned int syndrome = ::get_syndrome_23127(code);
+	unsigned int error_pattern = DECODING_TABLE_23127[syndrome];
+
+	errors = ::count_bits(error_pattern);
+
+	code ^= error_pattern;
+
+	return code >> 11;
+}
+
 unsigned int CGolay24128::decode24128(unsigned int code)
 {
 	return decode23127(code >> 1);
 }
 
+unsigned int CGolay24128::decode24128(unsigned int code, unsigned int& errors)
+{
+	return decode23127(code >> 1, errors);
+}
+
+void CGolay24128::decode24128(const unsigned int* codes, unsigned int* data, unsigned int count, unsigned int* errors)
+{
+	assert(codes != NULL);
+	assert(data != NULL);
+
+	unsigned int total = 0U;
+
+	for (unsigned int i = 0U; i < count; i++) {
+		unsigned int syndrome = ::get_syndrome_23127(codes[i] >> 1);
+		unsigned int error_pattern = DECODING_TABLE_23127[syndrome];
+
+		if (errors != NULL)
+			total += ::count_bits(error_pattern);
+
+		data[i] = ((codes[i] >> 1) ^ error_pattern) >> 11;
+	}
+
+	if (errors != NULL)
+		*errors = total;
+}
+
 unsigned int CGolay24128::decode24128(unsigned char* bytes)
 {
 	assert(bytes != NULL);
@@ -1106,3 +1191,29 @@ unsigned int CGolay24128::decode24128(unsigned char* bytes)
 
 	return decode23127(code >> 1);
 }
+
+void CGolay24128::decode24128(const unsigned char* bytes, unsigned int* data, unsigned int count, unsigned int* errors)
+{
+	assert(bytes != NULL);
+	assert(data != NULL);
+
+	unsigned int codes[8U];
+	unsigned int total = 0U;
+
+	while (count > 0U) {
+		unsigned int n = count < 8U ? count : 8U;
+
+		for (unsigned int i = 0U; i < n; i++, bytes += 3U)
+			codes[i] = (bytes[0U] << 16) | (bytes[1U] << 8) | bytes[2U];
+
+		unsigned int corrected = 0U;
+		decode24128(codes, data, n, errors != NULL ? &corrected : NULL);
+		total += corrected;
+
+		data  += n;
+		count -= n;
+	}
+
+	if (errors != NULL)
+		*errors = total;
+}
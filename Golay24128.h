@@ -19,6 +19,8 @@
 #ifndef Golay24128_H
 #define Golay24128_H
 
+#include <cstddef>
+
 class CGolay24128 {
 public:
 	static unsigned int encode23127(unsigned int data);
@@ -27,6 +29,14 @@ public:
 	static unsigned int decode23127(unsigned int code);
 	static unsigned int decode24128(unsigned int code);
 	static unsigned int decode24128(unsigned char* bytes);
+
+	// As above, also returning the number of bits that were corrected
+	static unsigned int decode23127(unsigned int code, unsigned int& errors);
+	static unsigned int decode24128(unsigned int code, unsigned int& errors);
+
+	// Decodes count codewords, the total of the corrected bits goes in errors if it is not NULL
+	static void decode24128(const unsigned int* codes, unsigned int* data, unsigned int count, unsigned int* errors = NULL);
+	static void decode24128(const unsigned char* bytes, unsigned int* data, unsigned int count, unsigned int* errors = NULL);
 };
 
 #endif
@@ -21,6 +21,92 @@
 #include <cstdio>
 #include <cassert>
 
+// Hamming (15,11,3): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_15113_1[4U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x03U, 0x05U, 0x06U, 0x06U, 0x05U, 0x03U, 0x00U, 0x07U, 0x04U, 0x02U, 0x01U, 0x01U, 0x02U, 0x04U, 0x07U},
+	{0x00U, 0x09U, 0x0AU, 0x03U, 0x0BU, 0x02U, 0x01U, 0x08U, 0x0CU, 0x05U, 0x06U, 0x0FU, 0x07U, 0x0EU, 0x0DU, 0x04U},
+	{0x00U, 0x0DU, 0x0EU, 0x03U, 0x0FU, 0x02U, 0x01U, 0x0CU, 0x00U, 0x0DU, 0x0EU, 0x03U, 0x0FU, 0x02U, 0x01U, 0x0CU}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_15113_1[] = {
+	0x0000U, 0x0001U, 0x0002U, 0x0010U, 0x0004U, 0x0020U, 0x0040U, 0x0080U,
+	0x0008U, 0x0100U, 0x0200U, 0x0400U, 0x0800U, 0x1000U, 0x2000U, 0x4000U};
+
+// Hamming (15,11,3): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_15113_2[4U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x03U, 0x06U, 0x05U, 0x0CU, 0x0FU, 0x0AU, 0x09U, 0x0BU, 0x08U, 0x0DU, 0x0EU, 0x07U, 0x04U, 0x01U, 0x02U},
+	{0x00U, 0x05U, 0x0AU, 0x0FU, 0x07U, 0x02U, 0x0DU, 0x08U, 0x0EU, 0x0BU, 0x04U, 0x01U, 0x09U, 0x0CU, 0x03U, 0x06U},
+	{0x00U, 0x0FU, 0x0DU, 0x02U, 0x09U, 0x06U, 0x04U, 0x0BU, 0x00U, 0x0FU, 0x0DU, 0x02U, 0x09U, 0x06U, 0x04U, 0x0BU}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_15113_2[] = {
+	0x0000U, 0x0001U, 0x0002U, 0x0010U, 0x0004U, 0x0100U, 0x0020U, 0x0400U,
+	0x0008U, 0x4000U, 0x0200U, 0x0080U, 0x0040U, 0x2000U, 0x0800U, 0x1000U};
+
+// Hamming (13,9,3): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_1393[4U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x03U, 0x06U, 0x05U, 0x0CU, 0x0FU, 0x0AU, 0x09U, 0x0BU, 0x08U, 0x0DU, 0x0EU, 0x07U, 0x04U, 0x01U, 0x02U},
+	{0x00U, 0x05U, 0x0AU, 0x0FU, 0x07U, 0x02U, 0x0DU, 0x08U, 0x0EU, 0x0BU, 0x04U, 0x01U, 0x09U, 0x0CU, 0x03U, 0x06U},
+	{0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU, 0x00U, 0x0FU}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_1393[] = {
+	0x0000U, 0x0001U, 0x0002U, 0x0010U, 0x0004U, 0x0100U, 0x0020U, 0x0400U,
+	0x0008U, 0x0000U, 0x0200U, 0x0080U, 0x0040U, 0x0000U, 0x0800U, 0x1000U};
+
+// Hamming (10,6,3): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_1063[3U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x0CU, 0x03U, 0x0FU, 0x07U, 0x0BU, 0x04U, 0x08U, 0x0BU, 0x07U, 0x08U, 0x04U, 0x0CU, 0x00U, 0x0FU, 0x03U},
+	{0x00U, 0x0DU, 0x0EU, 0x03U, 0x00U, 0x0DU, 0x0EU, 0x03U, 0x00U, 0x0DU, 0x0EU, 0x03U, 0x00U, 0x0DU, 0x0EU, 0x03U}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_1063[] = {
+	0x000U, 0x001U, 0x002U, 0x020U, 0x004U, 0x000U, 0x000U, 0x040U,
+	0x008U, 0x000U, 0x000U, 0x080U, 0x010U, 0x100U, 0x200U, 0x000U};
+
+// Hamming (16,11,4): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_16114[4U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x10U, 0x07U, 0x17U, 0x0DU, 0x1DU, 0x0AU, 0x1AU, 0x19U, 0x09U, 0x1EU, 0x0EU, 0x14U, 0x04U, 0x13U, 0x03U},
+	{0x00U, 0x16U, 0x0BU, 0x1DU, 0x15U, 0x03U, 0x1EU, 0x08U, 0x0EU, 0x18U, 0x05U, 0x13U, 0x1BU, 0x0DU, 0x10U, 0x06U},
+	{0x00U, 0x1CU, 0x1FU, 0x03U, 0x1AU, 0x06U, 0x05U, 0x19U, 0x13U, 0x0FU, 0x0CU, 0x10U, 0x09U, 0x15U, 0x16U, 0x0AU}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_16114[] = {
+	0x0000U, 0x0001U, 0x0002U, 0x0000U, 0x0004U, 0x0000U, 0x0000U, 0x0020U,
+	0x0008U, 0x0000U, 0x0000U, 0x0200U, 0x0000U, 0x0040U, 0x0800U, 0x0000U,
+	0x0010U, 0x0000U, 0x0000U, 0x8000U, 0x0000U, 0x0400U, 0x0100U, 0x0000U,
+	0x0000U, 0x0080U, 0x4000U, 0x0000U, 0x1000U, 0x0000U, 0x0000U, 0x2000U};
+
+// Hamming (17,12,3): the syndrome of each nibble of the code word, lowest nibble first
+static const unsigned char SYNDROME_TABLE_17123[5U][16U] = {
+	{0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU},
+	{0x00U, 0x10U, 0x05U, 0x15U, 0x0AU, 0x1AU, 0x0FU, 0x1FU, 0x14U, 0x04U, 0x11U, 0x01U, 0x1EU, 0x0EU, 0x1BU, 0x0BU},
+	{0x00U, 0x0DU, 0x1AU, 0x17U, 0x11U, 0x1CU, 0x0BU, 0x06U, 0x07U, 0x0AU, 0x1DU, 0x10U, 0x16U, 0x1BU, 0x0CU, 0x01U},
+	{0x00U, 0x0EU, 0x1CU, 0x12U, 0x1DU, 0x13U, 0x01U, 0x0FU, 0x1FU, 0x11U, 0x03U, 0x0DU, 0x02U, 0x0CU, 0x1EU, 0x10U},
+	{0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU, 0x00U, 0x1BU}};
+
+// The bit to flip for each syndrome, zero when there is none
+static const unsigned int CORRECTION_TABLE_17123[] = {
+	0x00000U, 0x00001U, 0x00002U, 0x00000U, 0x00004U, 0x00020U, 0x00000U, 0x00800U,
+	0x00008U, 0x00000U, 0x00040U, 0x00000U, 0x00000U, 0x00100U, 0x01000U, 0x00000U,
+	0x00010U, 0x00400U, 0x00000U, 0x00000U, 0x00080U, 0x00000U, 0x00000U, 0x00000U,
+	0x00000U, 0x00000U, 0x00200U, 0x10000U, 0x02000U, 0x04000U, 0x00000U, 0x08000U};
+
+// The syndrome of a packed code word, which lines up with its parity bits
+static inline unsigned int syndrome(const unsigned char table[][16U], unsigned int nibbles, unsigned int d)
+{
+	unsigned int s = 0U;
+	for (unsigned int i = 0U; i < nibbles; i++, d >>= 4)
+		s ^= table[i][d & 0x0FU];
+
+	return s;
+}
+
  // Hamming (15,11,3) check a boolean data array
 bool CHamming::decode15113_1(bool* d)
 {
@@ -347,3 +433,99 @@ void CHamming::encode17123(bool* d)
 	d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
 	d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
 }
+
+bool CHamming::decode15113_1(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_15113_1, 4U, d);
+
+	unsigned int error = CORRECTION_TABLE_15113_1[s];
+	d ^= error;
+
+	return error != 0U;
+}
+
+void CHamming::encode15113_1(unsigned int& d)
+{
+	d &= ~0xFU;
+	d |= syndrome(SYNDROME_TABLE_15113_1, 4U, d);
+}
+
+bool CHamming::decode15113_2(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_15113_2, 4U, d);
+
+	unsigned int error = CORRECTION_TABLE_15113_2[s];
+	d ^= error;
+
+	return error != 0U;
+}
+
+void CHamming::encode15113_2(unsigned int& d)
+{
+	d &= ~0xFU;
+	d |= syndrome(SYNDROME_TABLE_15113_2, 4U, d);
+}
+
+bool CHamming::decode1393(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_1393, 4U, d);
+
+	unsigned int error = CORRECTION_TABLE_1393[s];
+	d ^= error;
+
+	return error != 0U;
+}
+
+void CHamming::encode1393(unsigned int& d)
+{
+	d &= ~0xFU;
+	d |= syndrome(SYNDROME_TABLE_1393, 4U, d);
+}
+
+bool CHamming::decode1063(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_1063, 3U, d);
+
+	unsigned int error = CORRECTION_TABLE_1063[s];
+	d ^= error;
+
+	return error != 0U;
+}
+
+void CHamming::encode1063(unsigned int& d)
+{
+	d &= ~0xFU;
+	d |= syndrome(SYNDROME_TABLE_1063, 3U, d);
+}
+
+bool CHamming::decode16114(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_16114, 4U, d);
+
+	unsigned int error = CORRECTION_TABLE_16114[s];
+	d ^= error;
+
+	return s == 0U || error != 0U;
+}
+
+void CHamming::encode16114(unsigned int& d)
+{
+	d &= ~0x1FU;
+	d |= syndrome(SYNDROME_TABLE_16114, 4U, d);
+}
+
+bool CHamming::decode17123(unsigned int& d)
+{
+	unsigned int s = syndrome(SYNDROME_TABLE_17123, 5U, d);
+
+	unsigned int error = CORRECTION_TABLE_17123[s];
+	d ^= error;
+
+	return s == 0U || error != 0U;
+}
+
+void CHamming::encode17123(unsigned int& d)
+{
+	d &= ~0x1FU;
+	d |= syndrome(SYNDROME_TABLE_17123, 5U, d);
+}
@@ -38,6 +38,26 @@ public:
 
 	static void encode17123(bool* d);
 	static bool decode17123(bool* d);
+
+	// The same codes on a packed code word, the first bit of the bool
+	// version in the most significant bit and the parity bits lowest
+	static void encode15113_1(unsigned int& d);
+	static bool decode15113_1(unsigned int& d);
+
+	static void encode15113_2(unsigned int& d);
+	static bool decode15113_2(unsigned int& d);
+
+	static void encode1393(unsigned int& d);
+	static bool decode1393(unsigned int& d);
+
+	static void encode1063(unsigned int& d);
+	static bool decode1063(unsigned int& d);
+
+	static void encode16114(unsigned int& d);
+	static bool decode16114(unsigned int& d);
+
+	static void encode17123(unsigned int& d);
+	static bool decode17123(unsigned int& d);
 };
 
 #endif
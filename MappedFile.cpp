@@ -0,0 +1,134 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "MappedFile.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstdio>
+
+CMappedFile::CMappedFile() :
+m_data(NULL),
+m_length(0U)
+#if defined(_WIN32) || defined(_WIN64)
+,
+m_file(INVALID_HANDLE_VALUE),
+m_mapping(NULL)
+#endif
+{
+}
+
+CMappedFile::~CMappedFile()
+{
+	close();
+}
+
+bool CMappedFile::open(const std::string& filename)
+{
+	close();
+
+#if defined(_WIN32) || defined(_WIN64)
+	m_file = ::CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (m_file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(m_file, &size)) {
+		close();
+		return false;
+	}
+
+	// A mapping cannot be empty
+	if (size.QuadPart == 0)
+		return true;
+
+	m_mapping = ::CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+	void* data = m_mapping != NULL ? ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	if (data == NULL) {
+		close();
+		return false;
+	}
+
+	m_length = size_t(size.QuadPart);
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (::fstat(fd, &st) < 0) {
+		::close(fd);
+		return false;
+	}
+
+	// A mapping cannot be empty
+	if (st.st_size == 0) {
+		::close(fd);
+		return true;
+	}
+
+	void* data = ::mmap(NULL, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (data == MAP_FAILED)
+		return false;
+
+	m_length = size_t(st.st_size);
+#endif
+
+	m_data = (unsigned char*)data;
+
+	return true;
+}
+
+void CMappedFile::close()
+{
+#if defined(_WIN32) || defined(_WIN64)
+	if (m_data != NULL)
+		::UnmapViewOfFile(m_data);
+	if (m_mapping != NULL)
+		::CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE)
+		::CloseHandle(m_file);
+
+	m_mapping = NULL;
+	m_file    = INVALID_HANDLE_VALUE;
+#else
+	if (m_data != NULL)
+		::munmap(m_data, m_length);
+#endif
+
+	m_data   = NULL;
+	m_length = 0U;
+}
+
+const unsigned char* CMappedFile::getData() const
+{
+	return m_data;
+}
+
+size_t CMappedFile::getLength() const
+{
+	return m_length;
+}
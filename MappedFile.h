@@ -0,0 +1,57 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(MAPPEDFILE_H)
+#define	MAPPEDFILE_H
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#endif
+
+#include <string>
+#include <cstddef>
+
+// A file mapped read only. An empty file opens with no data. Only for files
+// that are replaced by renaming rather than rewritten, as reading past the
+// end of a mapped file that has been cut short raises SIGBUS.
+class CMappedFile {
+public:
+	CMappedFile();
+	~CMappedFile();
+
+	bool open(const std::string& filename);
+
+	void close();
+
+	const unsigned char* getData() const;
+
+	size_t getLength() const;
+
+private:
+	unsigned char* m_data;
+	size_t         m_length;
+#if defined(_WIN32) || defined(_WIN64)
+	HANDLE         m_file;
+	HANDLE         m_mapping;
+#endif
+
+	CMappedFile(const CMappedFile&);
+	CMappedFile& operator=(const CMappedFile&);
+};
+
+#endif
@@ -446,12 +446,47 @@ const unsigned int PRNG_TABLE[] = {
 	0xECDB0FU, 0xB542DAU, 0x9E5131U, 0xC7ABA5U, 0x8C38FEU, 0x97010BU, 0xDED290U, 0xA4CC7DU, 0xAD3D2EU, 0xF6B6B3U, 
 	0xF9A540U, 0x205ED9U, 0x634EB6U, 0x5A9567U, 0x11A6D8U, 0x0B3F09U};
 
-const unsigned int DMR_A_TABLE[] = { 0U,  4U,  8U, 12U, 16U, 20U, 24U, 28U, 32U, 36U, 40U, 44U,
-									48U, 52U, 56U, 60U, 64U, 68U,  1U,  5U,  9U, 13U, 17U, 21U};
-const unsigned int DMR_B_TABLE[] = {25U, 29U, 33U, 37U, 41U, 45U, 49U, 53U, 57U, 61U, 65U, 69U,
-									 2U,  6U, 10U, 14U, 18U, 22U, 26U, 30U, 34U, 38U, 42U, 46U};
-const unsigned int DMR_C_TABLE[] = {50U, 54U, 58U, 62U, 66U, 70U,  3U,  7U, 11U, 15U, 19U, 23U,
-									27U, 31U, 35U, 39U, 43U, 47U, 51U, 55U, 59U, 63U, 67U, 71U};
+// The 72 bits of a DMR AMBE frame are four interleaved streams of 18 bits,
+// the bits 4n, 4n+1, 4n+2 and 4n+3. A takes the first stream and the top 6
+// bits of the second, B the rest of the second and the top 12 bits of the
+// third, and C the rest of the third and all of the fourth. This table
+// splits a byte of the frame into the bit pairs of the four streams.
+const unsigned char AMBE_UNSHUFFLE[] = {
+	0x00U, 0x01U, 0x04U, 0x05U, 0x10U, 0x11U, 0x14U, 0x15U, 0x40U, 0x41U, 0x44U, 0x45U, 0x50U, 0x51U, 0x54U, 0x55U,
+	0x02U, 0x03U, 0x06U, 0x07U, 0x12U, 0x13U, 0x16U, 0x17U, 0x42U, 0x43U, 0x46U, 0x47U, 0x52U, 0x53U, 0x56U, 0x57U,
+	0x08U, 0x09U, 0x0CU, 0x0DU, 0x18U, 0x19U, 0x1CU, 0x1DU, 0x48U, 0x49U, 0x4CU, 0x4DU, 0x58U, 0x59U, 0x5CU, 0x5DU,
+	0x0AU, 0x0BU, 0x0EU, 0x0FU, 0x1AU, 0x1BU, 0x1EU, 0x1FU, 0x4AU, 0x4BU, 0x4EU, 0x4FU, 0x5AU, 0x5BU, 0x5EU, 0x5FU,
+	0x20U, 0x21U, 0x24U, 0x25U, 0x30U, 0x31U, 0x34U, 0x35U, 0x60U, 0x61U, 0x64U, 0x65U, 0x70U, 0x71U, 0x74U, 0x75U,
+	0x22U, 0x23U, 0x26U, 0x27U, 0x32U, 0x33U, 0x36U, 0x37U, 0x62U, 0x63U, 0x66U, 0x67U, 0x72U, 0x73U, 0x76U, 0x77U,
+	0x28U, 0x29U, 0x2CU, 0x2DU, 0x38U, 0x39U, 0x3CU, 0x3DU, 0x68U, 0x69U, 0x6CU, 0x6DU, 0x78U, 0x79U, 0x7CU, 0x7DU,
+	0x2AU, 0x2BU, 0x2EU, 0x2FU, 0x3AU, 0x3BU, 0x3EU, 0x3FU, 0x6AU, 0x6BU, 0x6EU, 0x6FU, 0x7AU, 0x7BU, 0x7EU, 0x7FU,
+	0x80U, 0x81U, 0x84U, 0x85U, 0x90U, 0x91U, 0x94U, 0x95U, 0xC0U, 0xC1U, 0xC4U, 0xC5U, 0xD0U, 0xD1U, 0xD4U, 0xD5U,
+	0x82U, 0x83U, 0x86U, 0x87U, 0x92U, 0x93U, 0x96U, 0x97U, 0xC2U, 0xC3U, 0xC6U, 0xC7U, 0xD2U, 0xD3U, 0xD6U, 0xD7U,
+	0x88U, 0x89U, 0x8CU, 0x8DU, 0x98U, 0x99U, 0x9CU, 0x9DU, 0xC8U, 0xC9U, 0xCCU, 0xCDU, 0xD8U, 0xD9U, 0xDCU, 0xDDU,
+	0x8AU, 0x8BU, 0x8EU, 0x8FU, 0x9AU, 0x9BU, 0x9EU, 0x9FU, 0xCAU, 0xCBU, 0xCEU, 0xCFU, 0xDAU, 0xDBU, 0xDEU, 0xDFU,
+	0xA0U, 0xA1U, 0xA4U, 0xA5U, 0xB0U, 0xB1U, 0xB4U, 0xB5U, 0xE0U, 0xE1U, 0xE4U, 0xE5U, 0xF0U, 0xF1U, 0xF4U, 0xF5U,
+	0xA2U, 0xA3U, 0xA6U, 0xA7U, 0xB2U, 0xB3U, 0xB6U, 0xB7U, 0xE2U, 0xE3U, 0xE6U, 0xE7U, 0xF2U, 0xF3U, 0xF6U, 0xF7U,
+	0xA8U, 0xA9U, 0xACU, 0xADU, 0xB8U, 0xB9U, 0xBCU, 0xBDU, 0xE8U, 0xE9U, 0xECU, 0xEDU, 0xF8U, 0xF9U, 0xFCU, 0xFDU,
+	0xAAU, 0xABU, 0xAEU, 0xAFU, 0xBAU, 0xBBU, 0xBEU, 0xBFU, 0xEAU, 0xEBU, 0xEEU, 0xEFU, 0xFAU, 0xFBU, 0xFEU, 0xFFU};
+
+// The inverse of AMBE_UNSHUFFLE
+const unsigned char AMBE_SHUFFLE[] = {
+	0x00U, 0x01U, 0x10U, 0x11U, 0x02U, 0x03U, 0x12U, 0x13U, 0x20U, 0x21U, 0x30U, 0x31U, 0x22U, 0x23U, 0x32U, 0x33U,
+	0x04U, 0x05U, 0x14U, 0x15U, 0x06U, 0x07U, 0x16U, 0x17U, 0x24U, 0x25U, 0x34U, 0x35U, 0x26U, 0x27U, 0x36U, 0x37U,
+	0x40U, 0x41U, 0x50U, 0x51U, 0x42U, 0x43U, 0x52U, 0x53U, 0x60U, 0x61U, 0x70U, 0x71U, 0x62U, 0x63U, 0x72U, 0x73U,
+	0x44U, 0x45U, 0x54U, 0x55U, 0x46U, 0x47U, 0x56U, 0x57U, 0x64U, 0x65U, 0x74U, 0x75U, 0x66U, 0x67U, 0x76U, 0x77U,
+	0x08U, 0x09U, 0x18U, 0x19U, 0x0AU, 0x0BU, 0x1AU, 0x1BU, 0x28U, 0x29U, 0x38U, 0x39U, 0x2AU, 0x2BU, 0x3AU, 0x3BU,
+	0x0CU, 0x0DU, 0x1CU, 0x1DU, 0x0EU, 0x0FU, 0x1EU, 0x1FU, 0x2CU, 0x2DU, 0x3CU, 0x3DU, 0x2EU, 0x2FU, 0x3EU, 0x3FU,
+	0x48U, 0x49U, 0x58U, 0x59U, 0x4AU, 0x4BU, 0x5AU, 0x5BU, 0x68U, 0x69U, 0x78U, 0x79U, 0x6AU, 0x6BU, 0x7AU, 0x7BU,
+	0x4CU, 0x4DU, 0x5CU, 0x5DU, 0x4EU, 0x4FU, 0x5EU, 0x5FU, 0x6CU, 0x6DU, 0x7CU, 0x7DU, 0x6EU, 0x6FU, 0x7EU, 0x7FU,
+	0x80U, 0x81U, 0x90U, 0x91U, 0x82U, 0x83U, 0x92U, 0x93U, 0xA0U, 0xA1U, 0xB0U, 0xB1U, 0xA2U, 0xA3U, 0xB2U, 0xB3U,
+	0x84U, 0x85U, 0x94U, 0x95U, 0x86U, 0x87U, 0x96U, 0x97U, 0xA4U, 0xA5U, 0xB4U, 0xB5U, 0xA6U, 0xA7U, 0xB6U, 0xB7U,
+	0xC0U, 0xC1U, 0xD0U, 0xD1U, 0xC2U, 0xC3U, 0xD2U, 0xD3U, 0xE0U, 0xE1U, 0xF0U, 0xF1U, 0xE2U, 0xE3U, 0xF2U, 0xF3U,
+	0xC4U, 0xC5U, 0xD4U, 0xD5U, 0xC6U, 0xC7U, 0xD6U, 0xD7U, 0xE4U, 0xE5U, 0xF4U, 0xF5U, 0xE6U, 0xE7U, 0xF6U, 0xF7U,
+	0x88U, 0x89U, 0x98U, 0x99U, 0x8AU, 0x8BU, 0x9AU, 0x9BU, 0xA8U, 0xA9U, 0xB8U, 0xB9U, 0xAAU, 0xABU, 0xBAU, 0xBBU,
+	0x8CU, 0x8DU, 0x9CU, 0x9DU, 0x8EU, 0x8FU, 0x9EU, 0x9FU, 0xACU, 0xADU, 0xBCU, 0xBDU, 0xAEU, 0xAFU, 0xBEU, 0xBFU,
+	0xC8U, 0xC9U, 0xD8U, 0xD9U, 0xCAU, 0xCBU, 0xDAU, 0xDBU, 0xE8U, 0xE9U, 0xF8U, 0xF9U, 0xEAU, 0xEBU, 0xFAU, 0xFBU,
+	0xCCU, 0xCDU, 0xDCU, 0xDDU, 0xCEU, 0xCFU, 0xDEU, 0xDFU, 0xECU, 0xEDU, 0xFCU, 0xFDU, 0xEEU, 0xEFU, 0xFEU, 0xFFU};
 
 const unsigned int INTERLEAVE_TABLE_26_4[] = {
 	0U, 4U,  8U, 12U, 16U, 20U, 24U, 28U, 32U, 36U, 40U, 44U, 48U, 52U, 56U, 60U, 64U, 68U, 72U, 76U, 80U, 84U, 88U, 92U, 96U, 100U,
@@ -462,15 +497,42 @@ const unsigned int INTERLEAVE_TABLE_26_4[] = {
 const unsigned char WHITENING_DATA[] = {0x93U, 0xD7U, 0x51U, 0x21U, 0x9CU, 0x2FU, 0x6CU, 0xD0U, 0xEFU, 0x0FU,
 										0xF8U, 0x3DU, 0xF1U, 0x73U, 0x20U, 0x94U, 0xEDU, 0x1EU, 0x7CU, 0xD8U};
 
+// The 49 bits of a VCH, A (12), B (12) and C (25) packed MSB first into the
+// top of a 64 bit word, sit at these bit positions of the 104 bit VCH before
+// it is whitened and interleaved. Each bit of A, B and the top 3 bits of C
+// is sent three times, the table points at the middle copy.
+static unsigned int VCH_BIT_POSITION(unsigned int j)
+{
+	if (j < 27U)
+		return 3U * j + 1U;
+	else
+		return j + 54U;
+}
+
+// XOR contributions of each input byte to the output of the fused kernels,
+// with the whitening already folded into the constant terms
+static unsigned long long VCH_ENCODE_TABLE[7U][256U][2U];
+static unsigned long long VCH_ENCODE_WHITENING[2U];
+static unsigned long long VCH_DECODE_TABLE[13U][256U];
+static unsigned long long VCH_DECODE_WHITENING;
+static bool               VCH_TABLES_INITIALISED = false;
+
 const unsigned char DMR_SILENCE[] = {0xB9U, 0xE8U, 0x81U, 0x52U, 0x61U, 0x73U, 0x00U, 0x2AU, 0x6BU};
 const unsigned char YSF_SILENCE[] = {0x7BU, 0xB2U, 0x8EU, 0x43U, 0x36U, 0xE4U, 0xA2U, 0x39U, 0x78U, 0x49U, 0x33U, 0x68U, 0x33U};
 
 CModeConv::CModeConv() :
-m_ysfN(0U),
-m_dmrN(0U),
-m_YSF(5000U, "DMR2YSF"),
-m_DMR(5000U, "YSF2DMR")
+m_clock(),
+m_YSF(512U, "DMR2YSF"),
+m_DMR(512U, "YSF2DMR"),
+m_ysfLatency(0U),
+m_dmrLatency(0U)
 {
+	m_clock.start();
+
+	if (!VCH_TABLES_INITIALISED) {
+		createVCHTables();
+		VCH_TABLES_INITIALISED = true;
+	}
 }
 
 CModeConv::~CModeConv()
@@ -481,116 +543,185 @@ void CModeConv::putDMR(unsigned char* bytes)
 {
 	assert(bytes != NULL);
 
-	unsigned int a1 = 0U, a2 = 0U, a3 = 0U;
-	unsigned int b1 = 0U, b2 = 0U, b3 = 0U;
-	unsigned int c1 = 0U, c2 = 0U, c3 = 0U;
-
-	unsigned int MASK = 0x800000U;
-	for (unsigned int i = 0U; i < 24U; i++) {
-		unsigned int a1Pos = DMR_A_TABLE[i];
-		unsigned int b1Pos = DMR_B_TABLE[i];
-		unsigned int c1Pos = DMR_C_TABLE[i];
-
-		unsigned int a2Pos = a1Pos + 72U;
-		if (a2Pos >= 108U)
-			a2Pos += 48U;
-		unsigned int b2Pos = b1Pos + 72U;
-		if (b2Pos >= 108U)
-			b2Pos += 48U;
-		unsigned int c2Pos = c1Pos + 72U;
-		if (c2Pos >= 108U)
-			c2Pos += 48U;
-
-		unsigned int a3Pos = a1Pos + 192U;
-		unsigned int b3Pos = b1Pos + 192U;
-		unsigned int c3Pos = c1Pos + 192U;
-
-		if (READ_BIT(bytes, a1Pos))
-			a1 |= MASK;
-		if (READ_BIT(bytes, a2Pos))
-			a2 |= MASK;
-		if (READ_BIT(bytes, a3Pos))
-			a3 |= MASK;
-		if (READ_BIT(bytes, b1Pos))
-			b1 |= MASK;
-		if (READ_BIT(bytes, b2Pos))
-			b2 |= MASK;
-		if (READ_BIT(bytes, b3Pos))
-			b3 |= MASK;
-		if (READ_BIT(bytes, c1Pos))
-			c1 |= MASK;
-		if (READ_BIT(bytes, c2Pos))
-			c2 |= MASK;
-		if (READ_BIT(bytes, c3Pos))
-			c3 |= MASK;
-
-		MASK >>= 1;
+	// The second frame is split around the sync in the middle of the burst
+	unsigned char frame[9U];
+	::memcpy(frame, bytes + 9U, 4U);
+	frame[4U] = (bytes[13U] & 0xF0U) | (bytes[19U] & 0x0FU);
+	::memcpy(frame + 5U, bytes + 20U, 4U);
+
+	unsigned int a[3U], b[3U], c[3U];
+	decodeAMBE(bytes, a[0U], b[0U], c[0U]);
+	decodeAMBE(frame, a[1U], b[1U], c[1U]);
+	decodeAMBE(bytes + 24U, a[2U], b[2U], c[2U]);
+
+	unsigned int dat_a[3U], dat_b[3U];
+	CGolay24128::decode24128(a, dat_a, 3U);
+
+	// The PRNG
+	for (unsigned int i = 0U; i < 3U; i++)
+		b[i] ^= PRNG_TABLE[dat_a[i]];
+
+	CGolay24128::decode24128(b, dat_b, 3U);
+
+	for (unsigned int i = 0U; i < 3U; i++)
+		putAMBE2YSF(dat_a[i], dat_b[i], c[i]);
+}
+
+void CModeConv::decodeAMBE(const unsigned char* frame, unsigned int& a, unsigned int& b, unsigned int& c)
+{
+	unsigned int s0 = 0U, s1 = 0U, s2 = 0U, s3 = 0U;
+
+	for (unsigned int i = 0U; i < 9U; i++) {
+		unsigned char pairs = AMBE_UNSHUFFLE[frame[i]];
+
+		s0 = (s0 << 2) | ((pairs >> 6) & 0x03U);
+		s1 = (s1 << 2) | ((pairs >> 4) & 0x03U);
+		s2 = (s2 << 2) | ((pairs >> 2) & 0x03U);
+		s3 = (s3 << 2) | ((pairs >> 0) & 0x03U);
 	}
 
-	putAMBE2YSF(a1, b1, c1);
-	putAMBE2YSF(a2, b2, c2);
-	putAMBE2YSF(a3, b3, c3);
+	a = (s0 << 6) | (s1 >> 12);
+	b = ((s1 & 0xFFFU) << 12) | (s2 >> 6);
+	c = ((s2 & 0x3FU) << 18) | s3;
 }
 
-void CModeConv::putAMBE2YSF(unsigned int a, unsigned int b, unsigned int dat_c)
+void CModeConv::encodeAMBE(unsigned int a, unsigned int b, unsigned int c, unsigned char* frame)
 {
-	unsigned char vch[13U];
-	unsigned char ysfFrame[13U];
-	::memset(vch, 0U, 13U);
-	::memset(ysfFrame, 0, 13U);
+	unsigned int s0 = a >> 6;
+	unsigned int s1 = ((a & 0x3FU) << 12) | ((b >> 12) & 0xFFFU);
+	unsigned int s2 = ((b & 0xFFFU) << 6) | ((c >> 18) & 0x3FU);
+	unsigned int s3 = c & 0x3FFFFU;
 
-	unsigned int dat_a = CGolay24128::decode24128(a);
+	for (unsigned int i = 0U; i < 9U; i++) {
+		unsigned int shift = 16U - 2U * i;
 
-	// The PRNG
-	unsigned int p = PRNG_TABLE[dat_a];
-	b ^= p;
+		unsigned char pairs = (((s0 >> shift) & 0x03U) << 6) |
+							  (((s1 >> shift) & 0x03U) << 4) |
+							  (((s2 >> shift) & 0x03U) << 2) |
+							  (((s3 >> shift) & 0x03U) << 0);
+
+		frame[i] = AMBE_SHUFFLE[pairs];
+	}
+}
+
+void CModeConv::createVCHTables()
+{
+	// Where each bit of the VCH ends up after interleaving, as a bit of the output words
+	unsigned long long position[104U][2U];
+	for (unsigned int i = 0U; i < 104U; i++) {
+		unsigned int n = INTERLEAVE_TABLE_26_4[i];
+		position[i][0U] = n < 64U ? 1ULL << (63U - n) : 0ULL;
+		position[i][1U] = n < 64U ? 0ULL : 1ULL << (127U - n);
+	}
 
-	unsigned int dat_b = CGolay24128::decode24128(b);
+	VCH_ENCODE_WHITENING[0U] = VCH_ENCODE_WHITENING[1U] = 0ULL;
+	for (unsigned int i = 0U; i < 104U; i++) {
+		if (READ_BIT(WHITENING_DATA, i)) {
+			VCH_ENCODE_WHITENING[0U] |= position[i][0U];
+			VCH_ENCODE_WHITENING[1U] |= position[i][1U];
+		}
+	}
 
-	for (unsigned int i = 0U; i < 12U; i++) {
-		bool s = (dat_a << (20U + i)) & 0x80000000U;
-		WRITE_BIT(vch, 3*i + 0U, s);
-		WRITE_BIT(vch, 3*i + 1U, s);
-		WRITE_BIT(vch, 3*i + 2U, s);
+	VCH_DECODE_WHITENING = 0ULL;
+	for (unsigned int j = 0U; j < 49U; j++) {
+		if (READ_BIT(WHITENING_DATA, VCH_BIT_POSITION(j)))
+			VCH_DECODE_WHITENING |= 1ULL << (63U - j);
 	}
-	
-	for (unsigned int i = 0U; i < 12U; i++) {
-		bool s = (dat_b << (20U + i)) & 0x80000000U;
-		WRITE_BIT(vch, 3*(i + 12U) + 0U, s);
-		WRITE_BIT(vch, 3*(i + 12U) + 1U, s);
-		WRITE_BIT(vch, 3*(i + 12U) + 2U, s);
+
+	for (unsigned int byte = 0U; byte < 7U; byte++) {
+		for (unsigned int value = 0U; value < 256U; value++) {
+			unsigned long long out[2U] = {0ULL, 0ULL};
+
+			for (unsigned int bit = 0U; bit < 8U; bit++) {
+				unsigned int j = byte * 8U + bit;
+				if (j >= 49U || (value & (0x80U >> bit)) == 0U)
+					continue;
+
+				// The first 27 bits are repeated three times
+				unsigned int first = j < 27U ? 3U * j : j + 54U;
+				unsigned int count = j < 27U ? 3U : 1U;
+				for (unsigned int k = 0U; k < count; k++) {
+					out[0U] |= position[first + k][0U];
+					out[1U] |= position[first + k][1U];
+				}
+			}
+
+			VCH_ENCODE_TABLE[byte][value][0U] = out[0U];
+			VCH_ENCODE_TABLE[byte][value][1U] = out[1U];
+		}
 	}
-	
-	for (unsigned int i = 0U; i < 3U; i++) {
-		bool s = (dat_c << (7U + i)) & 0x80000000U;
-		WRITE_BIT(vch, 3*(i + 24U) + 0U, s);
-		WRITE_BIT(vch, 3*(i + 24U) + 1U, s);
-		WRITE_BIT(vch, 3*(i + 24U) + 2U, s);
+
+	// Which VCH bit each interleaved bit came from
+	unsigned int source[104U];
+	for (unsigned int i = 0U; i < 104U; i++)
+		source[INTERLEAVE_TABLE_26_4[i]] = i;
+
+	// And which bit of A, B and C that VCH bit carries, if any
+	int carries[104U];
+	for (unsigned int i = 0U; i < 104U; i++)
+		carries[i] = -1;
+	for (unsigned int j = 0U; j < 49U; j++)
+		carries[VCH_BIT_POSITION(j)] = int(j);
+
+	for (unsigned int byte = 0U; byte < 13U; byte++) {
+		for (unsigned int value = 0U; value < 256U; value++) {
+			unsigned long long out = 0ULL;
+
+			for (unsigned int bit = 0U; bit < 8U; bit++) {
+				if ((value & (0x80U >> bit)) == 0U)
+					continue;
+
+				int j = carries[source[byte * 8U + bit]];
+				if (j >= 0)
+					out |= 1ULL << (63 - j);
+			}
+
+			VCH_DECODE_TABLE[byte][value] = out;
+		}
 	}
+}
 
-	for (unsigned int i = 0U; i < 22U; i++) {
-		bool s = (dat_c << (10U + i)) & 0x80000000U;
-		WRITE_BIT(vch, i + 81U, s);
+void CModeConv::encodeVCH(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c, unsigned char* frame)
+{
+	unsigned long long in = ((unsigned long long)(dat_a & 0xFFFU) << 52) |
+							((unsigned long long)(dat_b & 0xFFFU) << 40) |
+							((unsigned long long)(dat_c & 0x1FFFFFFU) << 15);
+
+	unsigned long long out0 = VCH_ENCODE_WHITENING[0U];
+	unsigned long long out1 = VCH_ENCODE_WHITENING[1U];
+
+	for (unsigned int i = 0U; i < 7U; i++) {
+		const unsigned long long* entry = VCH_ENCODE_TABLE[i][(in >> (56U - 8U * i)) & 0xFFU];
+		out0 ^= entry[0U];
+		out1 ^= entry[1U];
 	}
-	
-	WRITE_BIT(vch, 103U, 0U);
 
-	// Scramble
+	for (unsigned int i = 0U; i < 8U; i++)
+		frame[i] = (unsigned char)(out0 >> (56U - 8U * i));
+	for (unsigned int i = 0U; i < 5U; i++)
+		frame[i + 8U] = (unsigned char)(out1 >> (56U - 8U * i));
+}
+
+void CModeConv::decodeVCH(const unsigned char* frame, unsigned int& dat_a, unsigned int& dat_b, unsigned int& dat_c)
+{
+	unsigned long long out = VCH_DECODE_WHITENING;
+
 	for (unsigned int i = 0U; i < 13U; i++)
-		vch[i] ^= WHITENING_DATA[i];
+		out ^= VCH_DECODE_TABLE[i][frame[i]];
 
-	// Interleave
-	for (unsigned int i = 0U; i < 104U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_26_4[i];
-		bool s = READ_BIT(vch, i);
-		WRITE_BIT(ysfFrame, n, s);
-	}
+	dat_a = (unsigned int)(out >> 52) & 0xFFFU;
+	dat_b = (unsigned int)(out >> 40) & 0xFFFU;
+	dat_c = (unsigned int)(out >> 15) & 0x1FFFFFFU;
+}
+
+void CModeConv::putAMBE2YSF(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c)
+{
+	unsigned char ysfFrame[13U];
 
-	m_YSF.addData(&TAG_DATA, 1U);
-	m_YSF.addData(ysfFrame, 13U);
+	encodeVCH(dat_a, dat_b, dat_c, ysfFrame);
+
+	m_YSF.push(TAG_DATA, ysfFrame, m_clock.elapsed());
 	//CUtils::dump(1U, "VCH V/D type 2:", ysfFrame, 13U);
-	
-	m_ysfN += 1U;
 }
 
 void CModeConv::putYSF(unsigned char* data)
@@ -604,46 +735,9 @@ void CModeConv::putYSF(unsigned char* data)
 	// We have a total of 5 VCH sections, iterate through each
 	for (unsigned int j = 0U; j < 5U; j++, offset += 144U) {
 
-		unsigned char vch[13U];
-		unsigned int dat_a = 0U;
-		unsigned int dat_b = 0U;
-		unsigned int dat_c = 0U;
-
-		// Deinterleave
-		for (unsigned int i = 0U; i < 104U; i++) {
-			unsigned int n = INTERLEAVE_TABLE_26_4[i];
-			bool s = READ_BIT(data, offset + n);
-			WRITE_BIT(vch, i, s);
-		}
-
-		// "Un-whiten" (descramble)
-		for (unsigned int i = 0U; i < 13U; i++)
-			vch[i] ^= WHITENING_DATA[i];
-	
-		for (unsigned int i = 0U; i < 12U; i++) {
-			dat_a <<= 1U;
-			if (READ_BIT(vch, 3U*i + 1U))
-				dat_a |= 0x01U;;
-		}
-		
-		for (unsigned int i = 0U; i < 12U; i++) {
-			dat_b <<= 1U;
-			if (READ_BIT(vch, 3U*(i + 12U) + 1U))
-				dat_b |= 0x01U;;
-		}
-		
-		for (unsigned int i = 0U; i < 3U; i++) {
-			dat_c <<= 1U;
-			if (READ_BIT(vch, 3U*(i + 24U) + 1U))
-				dat_c |= 0x01U;;
-		}
+		unsigned int dat_a, dat_b, dat_c;
+		decodeVCH(data + offset / 8U, dat_a, dat_b, dat_c);
 
-		for (unsigned int i = 0U; i < 22U; i++) {
-			dat_c <<= 1U;
-			if (READ_BIT(vch, i + 81U))
-				dat_c |= 0x01U;;
-		}
-		
 		putAMBE2DMR(dat_a, dat_b, dat_c);
 	}
 }
@@ -656,26 +750,12 @@ void CModeConv::putAMBE2DMR(unsigned int dat_a, unsigned int dat_b, unsigned int
 	unsigned int p = PRNG_TABLE[dat_a];
 	unsigned int b = CGolay24128::encode24128(dat_b);
 	b ^= p;
-	
-	unsigned int MASK = 0x800000U;
-	for (unsigned int i = 0U; i < 24U; i++) {
-		unsigned int aPos = DMR_A_TABLE[i];
-		unsigned int bPos = DMR_B_TABLE[i];
-		unsigned int cPos = DMR_C_TABLE[i];
-
-		WRITE_BIT(v_dmr, aPos, a & MASK);
-		WRITE_BIT(v_dmr, bPos, b & MASK);
-		WRITE_BIT(v_dmr, cPos, dat_c & MASK);
-
-		MASK >>= 1;
-	}
-	
-	m_DMR.addData(&TAG_DATA, 1U);
-	m_DMR.addData(v_dmr, 9U);
+
+	encodeAMBE(a, b, dat_c, v_dmr);
+
+	m_DMR.push(TAG_DATA, v_dmr, m_clock.elapsed());
 
 	//CUtils::dump(1U, "DMR Voice:", v_dmr, 9U);
-	
-	m_dmrN += 1U;
 }
 
 void CModeConv::putDMRHeader()
@@ -684,9 +764,7 @@ void CModeConv::putDMRHeader()
 
 	::memset(vch, 0, 13U);
 
-	m_YSF.addData(&TAG_HEADER, 1U);
-	m_YSF.addData(vch, 13U);
-	m_ysfN += 1U;
+	m_YSF.push(TAG_HEADER, vch, m_clock.elapsed());
 }
 
 void CModeConv::putDMREOT()
@@ -694,17 +772,14 @@ void CModeConv::putDMREOT()
 	unsigned char vch[13U];
 
 	::memset(vch, 0, 13U);
-	
-	unsigned int fill = 5U - (m_ysfN % 5U);
-	for (unsigned int i = 0U; i < fill; i++) {
-		m_YSF.addData(&TAG_DATA, 1U);
-		m_YSF.addData(YSF_SILENCE, 13U);
-		m_ysfN += 1U;
-	}
 
-	m_YSF.addData(&TAG_EOT, 1U);
-	m_YSF.addData(vch, 13U);
-	m_ysfN += 1U;
+	unsigned int time = m_clock.elapsed();
+
+	unsigned int fill = 5U - (m_YSF.size() % 5U);
+	for (unsigned int i = 0U; i < fill; i++)
+		m_YSF.push(TAG_DATA, YSF_SILENCE, time);
+
+	m_YSF.push(TAG_EOT, vch, time);
 }
 
 void CModeConv::putYSFHeader()
@@ -713,9 +788,7 @@ void CModeConv::putYSFHeader()
 
 	::memset(v_dmr, 0U, 9U);
 
-	m_DMR.addData(&TAG_HEADER, 1U);
-	m_DMR.addData(v_dmr, 9U);
-	m_dmrN += 1U;
+	m_DMR.push(TAG_HEADER, v_dmr, m_clock.elapsed());
 }
 
 void CModeConv::putYSFEOT()
@@ -723,108 +796,113 @@ void CModeConv::putYSFEOT()
 	unsigned char v_dmr[9U];
 
 	::memset(v_dmr, 0U, 9U);
-	
-	unsigned int fill = 3U - (m_dmrN % 3U);
-	for (unsigned int i = 0U; i < fill; i++) {
-		m_DMR.addData(&TAG_DATA, 1U);
-		m_DMR.addData(DMR_SILENCE, 9U);
-		m_dmrN += 1U;
-	}
 
-	m_DMR.addData(&TAG_EOT, 1U);
-	m_DMR.addData(v_dmr, 9U);
-	m_dmrN += 1U;
+	unsigned int time = m_clock.elapsed();
+
+	unsigned int fill = 3U - (m_DMR.size() % 3U);
+	for (unsigned int i = 0U; i < fill; i++)
+		m_DMR.push(TAG_DATA, DMR_SILENCE, time);
+
+	m_DMR.push(TAG_EOT, v_dmr, time);
 }
 
 unsigned int CModeConv::getDMR(unsigned char* data)
 {
-	unsigned char tmp[9U];
-	unsigned char tag[1U];
+	if (m_DMR.isEmpty())
+		return TAG_NODATA;
 
-	tag[0U] = TAG_NODATA;
+	const CFrameQueue<9U>::CFrame& first = m_DMR.peek();
 
-	if (m_dmrN >= 1U) {
-		m_DMR.peek(tag, 1U);
+	unsigned int latency = m_clock.elapsed() - first.m_time;
+	if (latency > m_dmrLatency)
+		m_dmrLatency = latency;
 
-		if (tag[0U] != TAG_DATA) {
-			m_DMR.getData(tag, 1U);
-			m_DMR.getData(data, 9U);
-			m_dmrN -= 1U;
-			return tag[0U];
-		}
+	if (first.m_tag != TAG_DATA) {
+		unsigned char tag = first.m_tag;
+		::memcpy(data, first.m_data, 9U);
+		m_DMR.pop();
+		return tag;
 	}
 
-	if (m_dmrN >= 3U) {
-		m_DMR.getData(tag, 1U);
-		m_DMR.getData(data, 9U);
-		m_dmrN -= 1U;
+	if (m_DMR.size() < 3U)
+		return TAG_NODATA;
 
-		m_DMR.getData(tag, 1U);
-		m_DMR.getData(tmp, 9U);
-		m_dmrN -= 1U;
+	// Three AMBE frames make up one DMR voice burst, the middle one straddles the sync
+	const unsigned char* tmp = m_DMR.peek(1U).m_data;
 
-		::memcpy(data + 9U, tmp, 4U);
-		data[13U] = tmp[4U] & 0xF0U;
-		data[19U] = tmp[4U] & 0x0FU;
-		::memcpy(data + 20U, tmp + 5U, 4U);
+	::memcpy(data, first.m_data, 9U);
+	::memcpy(data + 9U, tmp, 4U);
+	data[13U] = tmp[4U] & 0xF0U;
+	data[19U] = tmp[4U] & 0x0FU;
+	::memcpy(data + 20U, tmp + 5U, 4U);
+	::memcpy(data + 24U, m_DMR.peek(2U).m_data, 9U);
 
-		m_DMR.getData(tag, 1U);
-		m_DMR.getData(data + 24U, 9U);
-		m_dmrN -= 1U;
+	m_DMR.pop(3U);
 
-		return TAG_DATA;
-	}
-	else
-		return TAG_NODATA;
+	return TAG_DATA;
 }
 
 unsigned int CModeConv::getYSF(unsigned char* data)
 {
-	unsigned char tag[1U];
+	data += YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES;
 
-	tag[0U] = TAG_NODATA;
+	if (m_YSF.isEmpty())
+		return TAG_NODATA;
 
-	data += YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES;
-	
-	if (m_ysfN >= 1U) {
-		m_YSF.peek(tag, 1U);
-
-		if (tag[0U] != TAG_DATA) {
-			m_YSF.getData(tag, 1U);
-			m_YSF.getData(data, 13U);
-			m_ysfN -= 1U;
-			return tag[0U];
-		}
-	}
+	const CFrameQueue<13U>::CFrame& first = m_YSF.peek();
+
+	unsigned int latency = m_clock.elapsed() - first.m_time;
+	if (latency > m_ysfLatency)
+		m_ysfLatency = latency;
 
-	if (m_ysfN >= 5U) {
-		data += 5U;
-		m_YSF.getData(tag, 1U);
-		m_YSF.getData(data, 13U);
-		m_ysfN -= 1U;
-
-		data += 18U;
-		m_YSF.getData(tag, 1U);
-		m_YSF.getData(data, 13U);
-		m_ysfN -= 1U;
-
-		data += 18U;
-		m_YSF.getData(tag, 1U);
-		m_YSF.getData(data, 13U);
-		m_ysfN -= 1U;
-
-		data += 18U;
-		m_YSF.getData(tag, 1U);
-		m_YSF.getData(data, 13U);
-		m_ysfN -= 1U;
-
-		data += 18U;
-		m_YSF.getData(tag, 1U);
-		m_YSF.getData(data, 13U);
-		m_ysfN -= 1U;
-
-		return TAG_DATA;
+	if (first.m_tag != TAG_DATA) {
+		unsigned char tag = first.m_tag;
+		::memcpy(data, first.m_data, 13U);
+		m_YSF.pop();
+		return tag;
 	}
-	else
+
+	if (m_YSF.size() < 5U)
 		return TAG_NODATA;
+
+	// Five VCH sections, each after a DCH section of 5 bytes
+	data += 5U;
+	for (unsigned int i = 0U; i < 5U; i++, data += 18U)
+		::memcpy(data, m_YSF.peek(i).m_data, 13U);
+
+	m_YSF.pop(5U);
+
+	return TAG_DATA;
+}
+
+bool CModeConv::hasYSF()
+{
+	if (m_YSF.size() >= 5U)
+		return true;
+
+	return !m_YSF.isEmpty() && m_YSF.peek().m_tag != TAG_DATA;
+}
+
+bool CModeConv::hasDMR()
+{
+	if (m_DMR.size() >= 3U)
+		return true;
+
+	return !m_DMR.isEmpty() && m_DMR.peek().m_tag != TAG_DATA;
+}
+
+unsigned int CModeConv::getYSFLatency()
+{
+	unsigned int latency = m_ysfLatency;
+	m_ysfLatency = 0U;
+
+	return latency;
+}
+
+unsigned int CModeConv::getDMRLatency()
+{
+	unsigned int latency = m_dmrLatency;
+	m_dmrLatency = 0U;
+
+	return latency;
 }
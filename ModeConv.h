@@ -19,7 +19,8 @@
 
 #include "Defines.h"
 #include "YSFDefines.h"
-#include "RingBuffer.h"
+#include "FrameQueue.h"
+#include "StopWatch.h"
 
 #if !defined(MODECONV_H)
 #define MODECONV_H
@@ -40,13 +41,28 @@ public:
 	unsigned int getYSF(unsigned char* bytes);
 	unsigned int getDMR(unsigned char* bytes);
 
+	bool hasYSF();
+	bool hasDMR();
+
+	// Longest time in ms a frame waited in the queue since the last call
+	unsigned int getYSFLatency();
+	unsigned int getDMRLatency();
+
+	// Splits a 9 byte DMR AMBE frame into its A, B and C words, and joins them again
+	static void decodeAMBE(const unsigned char* frame, unsigned int& a, unsigned int& b, unsigned int& c);
+	static void encodeAMBE(unsigned int a, unsigned int b, unsigned int c, unsigned char* frame);
+
 private:
-	void putAMBE2YSF(unsigned int a, unsigned int b, unsigned int dat_c);
+	void putAMBE2YSF(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c);
 	void putAMBE2DMR(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c);
-	unsigned int m_ysfN;
-	unsigned int m_dmrN;
-	CRingBuffer<unsigned char> m_YSF;
-	CRingBuffer<unsigned char> m_DMR;
+	void createVCHTables();
+	void encodeVCH(unsigned int dat_a, unsigned int dat_b, unsigned int dat_c, unsigned char* frame);
+	void decodeVCH(const unsigned char* frame, unsigned int& dat_a, unsigned int& dat_b, unsigned int& dat_c);
+	CStopWatch    m_clock;
+	CFrameQueue<13U> m_YSF;
+	CFrameQueue<9U>  m_DMR;
+	unsigned int  m_ysfLatency;
+	unsigned int  m_dmrLatency;
 
 };
 
@@ -25,10 +25,16 @@
 #include <cassert>
 #include <cstring>
 
+// The length is rounded up to a power of two so that the read and write
+// counters can run freely and be masked into an index. Transfers are done
+// as at most two memcpy calls, one each side of the wrap point, except
+// short ones, such as the length bytes, for which a call costs more than
+// copying them one at a time.
 template<class T> class CRingBuffer {
 public:
 	CRingBuffer(unsigned int length, const char* name) :
-	m_length(length),
+	m_length(1U),
+	m_mask(0U),
 	m_name(name),
 	m_buffer(NULL),
 	m_iPtr(0U),
@@ -37,7 +43,11 @@ public:
 		assert(length > 0U);
 		assert(name != NULL);
 
-		m_buffer = new T[length];
+		while (m_length < length)
+			m_length <<= 1;
+		m_mask = m_length - 1U;
+
+		m_buffer = new T[m_length];
 
 		::memset(m_buffer, 0x00, m_length * sizeof(T));
 	}
@@ -55,29 +65,30 @@ public:
 			return false;
 		}
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			m_buffer[m_iPtr++] = buffer[i];
-
-			if (m_iPtr == m_length)
-				m_iPtr = 0U;
+		if (nSamples <= SMALL_COPY) {
+			for (unsigned int i = 0U; i < nSamples; i++)
+				m_buffer[(m_iPtr + i) & m_mask] = buffer[i];
+		} else {
+			unsigned int ptr   = m_iPtr & m_mask;
+			unsigned int first = m_length - ptr;
+			if (first > nSamples)
+				first = nSamples;
+
+			::memcpy(m_buffer + ptr, buffer, first * sizeof(T));
+			::memcpy(m_buffer, buffer + first, (nSamples - first) * sizeof(T));
 		}
 
+		m_iPtr += nSamples;
+
 		return true;
 	}
 
 	bool getData(T* buffer, unsigned int nSamples)
 	{
-		if (dataSize() < nSamples) {
-			LogError("**** Underflow in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
+		if (!peek(buffer, nSamples))
 			return false;
-		}
-
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[m_oPtr++];
 
-			if (m_oPtr == m_length)
-				m_oPtr = 0U;
-		}
+		m_oPtr += nSamples;
 
 		return true;
 	}
@@ -85,16 +96,21 @@ public:
 	bool peek(T* buffer, unsigned int nSamples)
 	{
 		if (dataSize() < nSamples) {
-			LogError("**** Underflow peek in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
+			LogError("**** Underflow in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
 			return false;
 		}
 
-		unsigned int ptr = m_oPtr;
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[ptr++];
-
-			if (ptr == m_length)
-				ptr = 0U;
+		if (nSamples <= SMALL_COPY) {
+			for (unsigned int i = 0U; i < nSamples; i++)
+				buffer[i] = m_buffer[(m_oPtr + i) & m_mask];
+		} else {
+			unsigned int ptr   = m_oPtr & m_mask;
+			unsigned int first = m_length - ptr;
+			if (first > nSamples)
+				first = nSamples;
+
+			::memcpy(buffer, m_buffer + ptr, first * sizeof(T));
+			::memcpy(buffer + first, m_buffer, (nSamples - first) * sizeof(T));
 		}
 
 		return true;
@@ -110,22 +126,12 @@ public:
 
 	unsigned int freeSpace() const
 	{
-		unsigned int len = m_length;
-
-		if (m_oPtr > m_iPtr)
-			len = m_oPtr - m_iPtr;
-		else if (m_iPtr > m_oPtr)
-			len = m_length - (m_iPtr - m_oPtr);
-
-		if (len > m_length)
-			len = 0U;
-
-		return len;
+		return m_length - (m_iPtr - m_oPtr);
 	}
 
 	unsigned int dataSize() const
 	{
-		return m_length - freeSpace();
+		return m_iPtr - m_oPtr;
 	}
 
 	bool hasSpace(unsigned int length) const
@@ -144,7 +150,10 @@ public:
 	}
 
 private:
+	static const unsigned int SMALL_COPY = 16U;
+
 	unsigned int m_length;
+	unsigned int m_mask;
 	const char*  m_name;
 	T*           m_buffer;
 	unsigned int m_iPtr;
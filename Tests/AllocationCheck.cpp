@@ -0,0 +1,197 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Counts the heap allocations made while calls run through the objects
+// that handle every frame, in both directions, after a warm-up call has
+// filled the caches. Replacing the global operator new is the counting
+// allocator; any allocation in the steady state fails the check.
+
+#include "ModeConv.h"
+#include "YSFFICHCache.h"
+#include "YSFPayload.h"
+#include "YSFFICH.h"
+#include "DMRLCCache.h"
+#include "DMREmbeddedData.h"
+#include "DMRSlotType.h"
+#include "DMRFullLC.h"
+#include "DMRData.h"
+#include "DMREMB.h"
+#include "DMRLC.h"
+#include "Sync.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+static bool         g_counting    = false;
+static unsigned int g_allocations = 0U;
+
+void* operator new(std::size_t size)
+{
+	if (g_counting)
+		g_allocations++;
+
+	void* p = ::malloc(size == 0U ? 1U : size);
+	if (p == NULL)
+		throw std::bad_alloc();
+
+	return p;
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	::free(p);
+}
+
+const unsigned int   SUPERFRAMES = 1000U;
+const unsigned int   SRC_ID      = 2141234U;
+const unsigned int   DST_ID      = 9U;
+const unsigned char  COLOR_CODE  = 1U;
+
+// A V/D mode 2 frame with the given frame number and random voice
+static void createYSFFrame(unsigned char* frame, unsigned int fn)
+{
+	for (unsigned int i = 0U; i < YSF_FRAME_LENGTH_BYTES; i++)
+		frame[i] = (unsigned char)::rand();
+
+	CSync::addYSFSync(frame);
+
+	CYSFPayload payload;
+	payload.writeVDMode2Data(frame, (const unsigned char*)"          ");
+
+	CYSFFICH fich;
+	fich.setFI(YSF_FI_COMMUNICATIONS);
+	fich.setCS(2U);
+	fich.setFN(fn);
+	fich.setFT(7U);
+	fich.setDT(YSF_DT_VD_MODE2);
+	fich.encode(frame);
+}
+
+// One superframe each way, as the main loop handles it
+static void runSuperframe(CModeConv& conv, CYSFFICHCache& fichCache, CDMRLCCache& lcCache, unsigned char ysfFrames[][YSF_FRAME_LENGTH_BYTES], unsigned char dmrBursts[][DMR_FRAME_LENGTH_BYTES])
+{
+	unsigned char buffer[200U];
+
+	// YSF to DMR
+	for (unsigned int fn = 0U; fn < 8U; fn++) {
+		CYSFFICH fich;
+		if (fichCache.decode(ysfFrames[fn], fich) && fich.getDT() == YSF_DT_VD_MODE2)
+			conv.putYSF(ysfFrames[fn]);
+
+		CYSFFICH uncached;
+		uncached.decode(ysfFrames[fn]);
+	}
+
+	lcCache.getData(FLCO_GROUP, SRC_ID, DST_ID, COLOR_CODE, DT_VOICE_LC_HEADER, buffer);
+
+	unsigned int n = 0U;
+	while (conv.hasDMR()) {
+		conv.getDMR(buffer);
+
+		CDMRData data;
+		data.setSlotNo(2U);
+		data.setSrcId(SRC_ID);
+		data.setDstId(DST_ID);
+		data.setFLCO(FLCO_GROUP);
+		data.setN(n);
+		data.setDataType(n == 0U ? DT_VOICE_SYNC : DT_VOICE);
+		data.setData(buffer);
+
+		// The copies the queues between the threads make
+		CDMRData copy(data);
+		data = copy;
+
+		n = (n + 1U) % 6U;
+	}
+
+	// DMR to YSF
+	for (unsigned int i = 0U; i < 6U; i++) {
+		CDMRData data;
+		data.setDataType(i == 0U ? DT_VOICE_SYNC : DT_VOICE);
+		data.setData(dmrBursts[i]);
+
+		data.getData(buffer);
+		conv.putDMR(buffer);
+	}
+
+	while (conv.hasYSF())
+		conv.getYSF(buffer + 35U);
+
+	// The LC encoding done when a talker is not cached
+	CDMRLC lc(FLCO_GROUP, SRC_ID, DST_ID);
+
+	CDMRSlotType slotType;
+	slotType.setColorCode(COLOR_CODE);
+	slotType.setDataType(DT_TERMINATOR_WITH_LC);
+	slotType.getData(buffer);
+
+	CDMRFullLC fullLC;
+	fullLC.encode(lc, buffer, DT_TERMINATOR_WITH_LC);
+
+	CDMREmbeddedData embeddedLC;
+	embeddedLC.setLC(lc);
+
+	CDMREMB emb;
+	emb.setColorCode(COLOR_CODE);
+	for (unsigned int i = 1U; i <= 5U; i++) {
+		emb.setLCSS(embeddedLC.getData(buffer, i));
+		emb.getData(buffer);
+	}
+}
+
+int main()
+{
+	unsigned char ysfFrames[8U][YSF_FRAME_LENGTH_BYTES];
+	for (unsigned int fn = 0U; fn < 8U; fn++)
+		createYSFFrame(ysfFrames[fn], fn);
+
+	unsigned char dmrBursts[6U][DMR_FRAME_LENGTH_BYTES];
+	for (unsigned int i = 0U; i < 6U; i++) {
+		for (unsigned int j = 0U; j < DMR_FRAME_LENGTH_BYTES; j++)
+			dmrBursts[i][j] = (unsigned char)::rand();
+	}
+
+	CModeConv     conv;
+	CYSFFICHCache fichCache(16U);
+	CDMRLCCache   lcCache(8U);
+
+	runSuperframe(conv, fichCache, lcCache, ysfFrames, dmrBursts);
+
+	g_counting = true;
+
+	for (unsigned int i = 0U; i < SUPERFRAMES; i++)
+		runSuperframe(conv, fichCache, lcCache, ysfFrames, dmrBursts);
+
+	g_counting = false;
+
+	::fprintf(stdout, "%u allocations in %u superframes\n", g_allocations, SUPERFRAMES);
+
+	return g_allocations == 0U ? 0 : 1;
+}
@@ -0,0 +1,295 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares the packed BPTC(196,96) codec with the bool array one it
+// replaced, on random payloads encoded into bursts filled with other bits,
+// which must survive, and decoded again with up to five bit errors.
+
+#include "Bench.h"
+#include "BPTC19696.h"
+#include "Hamming.h"
+#include "Utils.h"
+
+#include <cstring>
+#include <cstdlib>
+
+const unsigned int PAYLOADS = 1000U;
+
+// The codec before the rework
+class COldBPTC19696 {
+public:
+	COldBPTC19696() :
+	m_rawData(NULL),
+	m_deInterData(NULL)
+	{
+		m_rawData     = new bool[196];
+		m_deInterData = new bool[196];
+	}
+
+	~COldBPTC19696()
+	{
+		delete[] m_rawData;
+		delete[] m_deInterData;
+	}
+
+	void decode(const unsigned char* in, unsigned char* out)
+	{
+		decodeExtractBinary(in);
+		decodeDeInterleave();
+		decodeErrorCheck();
+		decodeExtractData(out);
+	}
+
+	void encode(const unsigned char* in, unsigned char* out)
+	{
+		encodeExtractData(in);
+		encodeErrorCheck();
+		encodeInterleave();
+		encodeExtractBinary(out);
+	}
+
+private:
+	bool* m_rawData;
+	bool* m_deInterData;
+
+	void decodeExtractBinary(const unsigned char* in)
+	{
+		for (unsigned int i = 0U; i < 13U; i++)
+			CUtils::byteToBitsBE(in[i], m_rawData + i * 8U);
+
+		bool bits[8U];
+		CUtils::byteToBitsBE(in[20U], bits);
+		m_rawData[98U] = bits[6U];
+		m_rawData[99U] = bits[7U];
+
+		for (unsigned int i = 0U; i < 12U; i++)
+			CUtils::byteToBitsBE(in[21U + i], m_rawData + 100U + i * 8U);
+	}
+
+	void decodeDeInterleave()
+	{
+		for (unsigned int i = 0U; i < 196U; i++)
+			m_deInterData[i] = false;
+
+		for (unsigned int a = 0U; a < 196U; a++)
+			m_deInterData[a] = m_rawData[(a * 181U) % 196U];
+	}
+
+	void decodeErrorCheck()
+	{
+		bool fixing;
+		unsigned int count = 0U;
+		do {
+			fixing = false;
+
+			bool col[13U];
+			for (unsigned int c = 0U; c < 15U; c++) {
+				unsigned int pos = c + 1U;
+				for (unsigned int a = 0U; a < 13U; a++) {
+					col[a] = m_deInterData[pos];
+					pos = pos + 15U;
+				}
+
+				if (CHamming::decode1393(col)) {
+					unsigned int pos = c + 1U;
+					for (unsigned int a = 0U; a < 13U; a++) {
+						m_deInterData[pos] = col[a];
+						pos = pos + 15U;
+					}
+
+					fixing = true;
+				}
+			}
+
+			for (unsigned int r = 0U; r < 9U; r++) {
+				unsigned int pos = (r * 15U) + 1U;
+				if (CHamming::decode15113_2(m_deInterData + pos))
+					fixing = true;
+			}
+
+			count++;
+		} while (fixing && count < 5U);
+	}
+
+	// The first row has 8 payload bits, the other eight 11 each
+	void decodeExtractData(unsigned char* data) const
+	{
+		bool bData[96U];
+		unsigned int pos = 0U;
+		for (unsigned int a = 4U; a <= 11U; a++, pos++)
+			bData[pos] = m_deInterData[a];
+
+		for (unsigned int r = 1U; r < 9U; r++) {
+			for (unsigned int a = r * 15U + 1U; a <= r * 15U + 11U; a++, pos++)
+				bData[pos] = m_deInterData[a];
+		}
+
+		for (unsigned int i = 0U; i < 12U; i++)
+			CUtils::bitsToByteBE(bData + i * 8U, data[i]);
+	}
+
+	void encodeExtractData(const unsigned char* in) const
+	{
+		bool bData[96U];
+		for (unsigned int i = 0U; i < 12U; i++)
+			CUtils::byteToBitsBE(in[i], bData + i * 8U);
+
+		for (unsigned int i = 0U; i < 196U; i++)
+			m_deInterData[i] = false;
+
+		unsigned int pos = 0U;
+		for (unsigned int a = 4U; a <= 11U; a++, pos++)
+			m_deInterData[a] = bData[pos];
+
+		for (unsigned int r = 1U; r < 9U; r++) {
+			for (unsigned int a = r * 15U + 1U; a <= r * 15U + 11U; a++, pos++)
+				m_deInterData[a] = bData[pos];
+		}
+	}
+
+	void encodeErrorCheck()
+	{
+		for (unsigned int r = 0U; r < 9U; r++) {
+			unsigned int pos = (r * 15U) + 1U;
+			CHamming::encode15113_2(m_deInterData + pos);
+		}
+
+		bool col[13U];
+		for (unsigned int c = 0U; c < 15U; c++) {
+			unsigned int pos = c + 1U;
+			for (unsigned int a = 0U; a < 13U; a++) {
+				col[a] = m_deInterData[pos];
+				pos = pos + 15U;
+			}
+
+			CHamming::encode1393(col);
+
+			pos = c + 1U;
+			for (unsigned int a = 0U; a < 13U; a++) {
+				m_deInterData[pos] = col[a];
+				pos = pos + 15U;
+			}
+		}
+	}
+
+	void encodeInterleave()
+	{
+		for (unsigned int i = 0U; i < 196U; i++)
+			m_rawData[i] = false;
+
+		for (unsigned int a = 0U; a < 196U; a++)
+			m_rawData[(a * 181U) % 196U] = m_deInterData[a];
+	}
+
+	void encodeExtractBinary(unsigned char* data)
+	{
+		for (unsigned int i = 0U; i < 12U; i++)
+			CUtils::bitsToByteBE(m_rawData + i * 8U, data[i]);
+
+		unsigned char byte;
+		CUtils::bitsToByteBE(m_rawData + 96U, byte);
+		data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
+		data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
+
+		for (unsigned int i = 0U; i < 12U; i++)
+			CUtils::bitsToByteBE(m_rawData + 100U + i * 8U, data[21U + i]);
+	}
+};
+
+int main()
+{
+	unsigned int failures = 0U;
+
+	unsigned char payloads[PAYLOADS][12U];
+	unsigned char bursts[PAYLOADS][33U];
+
+	COldBPTC19696 oldBPTC;
+	CBPTC19696    newBPTC;
+
+	for (unsigned int i = 0U; i < PAYLOADS; i++) {
+		for (unsigned int j = 0U; j < 12U; j++)
+			payloads[i][j] = (unsigned char)::rand();
+
+		unsigned char burst1[33U], burst2[33U];
+		for (unsigned int j = 0U; j < 33U; j++)
+			burst1[j] = burst2[j] = (unsigned char)::rand();
+
+		oldBPTC.encode(payloads[i], burst1);
+		newBPTC.encode(payloads[i], burst2);
+		if (::memcmp(burst1, burst2, 33U) != 0)
+			failures++;
+
+		// Errors only in the BPTC bits, not in the slot type and sync between them
+		for (unsigned int e = 0U; e < i % 6U; e++) {
+			unsigned int bit = ::rand() % 264U;
+			if (bit < 98U || bit >= 166U)
+				burst1[bit / 8U] ^= 0x80U >> (bit % 8U);
+		}
+
+		::memcpy(bursts[i], burst1, 33U);
+
+		unsigned char out1[12U], out2[12U];
+		oldBPTC.decode(bursts[i], out1);
+		newBPTC.decode(bursts[i], out2);
+		if (::memcmp(out1, out2, 12U) != 0)
+			failures++;
+	}
+
+	double oldEncodeNs = benchmark([&]() {
+		unsigned char burst[33U];
+		for (unsigned int i = 0U; i < PAYLOADS; i++) {
+			oldBPTC.encode(payloads[i], burst);
+			consume(burst[0U]);
+		}
+	}, 10U) / double(PAYLOADS);
+
+	double newEncodeNs = benchmark([&]() {
+		unsigned char burst[33U];
+		for (unsigned int i = 0U; i < PAYLOADS; i++) {
+			newBPTC.encode(payloads[i], burst);
+			consume(burst[0U]);
+		}
+	}, 10U) / double(PAYLOADS);
+
+	double oldDecodeNs = benchmark([&]() {
+		unsigned char out[12U];
+		for (unsigned int i = 0U; i < PAYLOADS; i++) {
+			oldBPTC.decode(bursts[i], out);
+			consume(out[0U]);
+		}
+	}, 10U) / double(PAYLOADS);
+
+	double newDecodeNs = benchmark([&]() {
+		unsigned char out[12U];
+		for (unsigned int i = 0U; i < PAYLOADS; i++) {
+			newBPTC.decode(bursts[i], out);
+			consume(out[0U]);
+		}
+	}, 10U) / double(PAYLOADS);
+
+	::fprintf(stdout, "per header  old ns  new ns\n");
+	::fprintf(stdout, "encode     %7.0f %7.0f\n", oldEncodeNs, newEncodeNs);
+	::fprintf(stdout, "decode     %7.0f %7.0f\n", oldDecodeNs, newDecodeNs);
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u mismatches\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
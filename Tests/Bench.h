@@ -0,0 +1,56 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(BENCH_H)
+#define	BENCH_H
+
+#include <chrono>
+#include <cstdio>
+
+// Runs the body the given number of times per pass and returns the best
+// time per run of all passes in nanoseconds, the best pass being the one
+// least disturbed by the rest of the host.
+template<class F> double benchmark(F body, unsigned int runs, unsigned int passes = 25U)
+{
+	double best = 1.0E30;
+
+	for (unsigned int i = 0U; i < passes; i++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		for (unsigned int j = 0U; j < runs; j++)
+			body();
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / double(runs);
+		if (ns < best)
+			best = ns;
+	}
+
+	return best;
+}
+
+// Keeps the compiler from dropping a result that is never used
+static volatile unsigned int g_sink = 0U;
+
+inline void consume(unsigned int value)
+{
+	g_sink = g_sink + value;
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Checks the table-driven Golay(24,12,8) decoders against the original one
+// for every possible 24 bit word, both the decoded data and the number of
+// corrected bits, for the single word and the batch versions.
+
+#include "Golay24128.h"
+
+#include <cstdio>
+
+#define X22             0x00400000   /* vector representation of X^{22} */
+#define X11             0x00000800   /* vector representation of X^{11} */
+#define MASK12          0xfffff800   /* auxiliary vector for testing */
+#define GENPOL          0x00000c75   /* generator polinomial, g(x) */
+
+// The syndrome as computed before the tables, by long division
+static unsigned int oldSyndrome(unsigned int pattern)
+{
+	unsigned int aux = X22;
+
+	if (pattern >= X11) {
+		while (pattern & MASK12) {
+			while (!(aux & pattern))
+				aux = aux >> 1;
+
+			pattern ^= (aux / X11) * GENPOL;
+		}
+	}
+
+	return pattern;
+}
+
+static unsigned int countBits(unsigned int pattern)
+{
+	unsigned int count = 0U;
+
+	for (; pattern != 0U; pattern >>= 1)
+		count += pattern & 0x01U;
+
+	return count;
+}
+
+// The code is perfect, so the 2048 error patterns of up to three bits have
+// one syndrome each, which is how the original decoding table was built
+static unsigned int errorPatterns[2048U];
+
+static void createErrorPatterns()
+{
+	errorPatterns[0U] = 0U;
+
+	for (unsigned int i = 0U; i < 23U; i++) {
+		for (unsigned int j = i; j < 23U; j++) {
+			for (unsigned int k = j; k < 23U; k++) {
+				unsigned int pattern = (1U << i) | (1U << j) | (1U << k);
+				errorPatterns[oldSyndrome(pattern)] = pattern;
+			}
+		}
+	}
+}
+
+static unsigned int oldDecode(unsigned int code, unsigned int& errors)
+{
+	code >>= 1;
+
+	unsigned int pattern = errorPatterns[oldSyndrome(code)];
+	errors = countBits(pattern);
+
+	return (code ^ pattern) >> 11;
+}
+
+#define BATCH	256U
+
+int main()
+{
+	createErrorPatterns();
+
+	unsigned int mismatches = 0U;
+
+	for (unsigned int base = 0U; base < 0x1000000U; base += BATCH) {
+		unsigned int codes[BATCH];
+		unsigned char bytes[BATCH * 3U];
+		unsigned int expected[BATCH];
+
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			unsigned int code = base + i;
+			codes[i] = code;
+			bytes[i * 3U + 0U] = code >> 16;
+			bytes[i * 3U + 1U] = code >> 8;
+			bytes[i * 3U + 2U] = code;
+
+			unsigned int errors1 = 0U;
+			expected[i] = oldDecode(code, errors1);
+
+			unsigned int errors2 = 0U;
+			unsigned int data = CGolay24128::decode24128(code, errors2);
+			if (data != expected[i] || errors1 != errors2)
+				mismatches++;
+
+			if (CGolay24128::decode24128(code) != expected[i])
+				mismatches++;
+
+			if (CGolay24128::decode24128(bytes + i * 3U) != expected[i])
+				mismatches++;
+		}
+
+		unsigned int data[BATCH];
+		unsigned int total = 0U;
+
+		// Odd counts leave a partial group of eight at the end of the byte version
+		unsigned int count = (base / BATCH) % 2U == 0U ? BATCH : BATCH - 3U;
+
+		CGolay24128::decode24128(codes, data, count, &total);
+		unsigned int expectedCount = 0U;
+		for (unsigned int i = 0U; i < count; i++) {
+			if (data[i] != expected[i])
+				mismatches++;
+			unsigned int errors = 0U;
+			oldDecode(codes[i], errors);
+			expectedCount += errors;
+		}
+		if (total != expectedCount)
+			mismatches++;
+
+		CGolay24128::decode24128(bytes, data, count, &total);
+		for (unsigned int i = 0U; i < count; i++) {
+			if (data[i] != expected[i])
+				mismatches++;
+		}
+		if (total != expectedCount)
+			mismatches++;
+
+		CGolay24128::decode24128(codes, data, BATCH);
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			if (data[i] != expected[i])
+				mismatches++;
+		}
+	}
+
+	::fprintf(stdout, "Golay(24,12)     %u words, %u mismatches\n", 0x1000000U, mismatches);
+
+	return mismatches == 0U ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Checks the packed Hamming codecs against the bool array versions for
+// every possible word of every code, both encoding and decoding, including
+// the return value that says whether a bit was corrected.
+
+#include "Hamming.h"
+
+#include <cstdio>
+
+typedef void (*BOOL_ENCODER)(bool* d);
+typedef bool (*BOOL_DECODER)(bool* d);
+typedef void (*PACKED_ENCODER)(unsigned int& d);
+typedef bool (*PACKED_DECODER)(unsigned int& d);
+
+// The first bit of the bool version is the most significant of the packed one
+static void unpack(unsigned int word, unsigned int n, bool* d)
+{
+	for (unsigned int i = 0U; i < n; i++)
+		d[i] = ((word >> (n - 1U - i)) & 0x01U) == 0x01U;
+}
+
+static unsigned int pack(const bool* d, unsigned int n)
+{
+	unsigned int word = 0U;
+	for (unsigned int i = 0U; i < n; i++)
+		word = (word << 1) | (d[i] ? 0x01U : 0x00U);
+
+	return word;
+}
+
+static unsigned int check(const char* name, unsigned int n, BOOL_ENCODER boolEncode, BOOL_DECODER boolDecode, PACKED_ENCODER packedEncode, PACKED_DECODER packedDecode)
+{
+	unsigned int mismatches = 0U;
+	unsigned int words = 1U << n;
+
+	for (unsigned int word = 0U; word < words; word++) {
+		bool d[32U];
+
+		unpack(word, n, d);
+		bool corrected1 = boolDecode(d);
+		unsigned int packed = word;
+		bool corrected2 = packedDecode(packed);
+		if (corrected1 != corrected2 || pack(d, n) != packed)
+			mismatches++;
+
+		unpack(word, n, d);
+		boolEncode(d);
+		packed = word;
+		packedEncode(packed);
+		if (pack(d, n) != packed)
+			mismatches++;
+	}
+
+	::fprintf(stdout, "%-16s %6u words, %u mismatches\n", name, words, mismatches);
+
+	return mismatches;
+}
+
+int main()
+{
+	unsigned int mismatches = 0U;
+
+	mismatches += check("Hamming(15,11) 1", 15U, CHamming::encode15113_1, CHamming::decode15113_1, CHamming::encode15113_1, CHamming::decode15113_1);
+	mismatches += check("Hamming(15,11) 2", 15U, CHamming::encode15113_2, CHamming::decode15113_2, CHamming::encode15113_2, CHamming::decode15113_2);
+	mismatches += check("Hamming(13,9)",    13U, CHamming::encode1393,    CHamming::decode1393,    CHamming::encode1393,    CHamming::decode1393);
+	mismatches += check("Hamming(10,6)",    10U, CHamming::encode1063,    CHamming::decode1063,    CHamming::encode1063,    CHamming::decode1063);
+	mismatches += check("Hamming(16,11)",   16U, CHamming::encode16114,   CHamming::decode16114,   CHamming::encode16114,   CHamming::decode16114);
+	mismatches += check("Hamming(17,12)",   17U, CHamming::encode17123,   CHamming::decode17123,   CHamming::encode17123,   CHamming::decode17123);
+
+	return mismatches == 0U ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares the table driven AMBE frame splitting and joining of CModeConv
+// with the bit by bit loops it replaced, per DMR voice burst of three
+// frames, and times whole bursts going through the converter both ways.
+
+#include "Bench.h"
+#include "ModeConv.h"
+
+#include <cstring>
+#include <cstdlib>
+
+const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+
+// The bit positions of the old converter
+const unsigned int DMR_A_TABLE[] = { 0U,  4U,  8U, 12U, 16U, 20U, 24U, 28U, 32U, 36U, 40U, 44U,
+									48U, 52U, 56U, 60U, 64U, 68U,  1U,  5U,  9U, 13U, 17U, 21U};
+const unsigned int DMR_B_TABLE[] = {25U, 29U, 33U, 37U, 41U, 45U, 49U, 53U, 57U, 61U, 65U, 69U,
+									 2U,  6U, 10U, 14U, 18U, 22U, 26U, 30U, 34U, 38U, 42U, 46U};
+const unsigned int DMR_C_TABLE[] = {50U, 54U, 58U, 62U, 66U, 70U,  3U,  7U, 11U, 15U, 19U, 23U,
+									27U, 31U, 35U, 39U, 43U, 47U, 51U, 55U, 59U, 63U, 67U, 71U};
+
+const unsigned int BURSTS = 256U;
+
+// The loop of the old putDMR
+static void oldSplit(const unsigned char* bytes, unsigned int* a, unsigned int* b, unsigned int* c)
+{
+	a[0U] = a[1U] = a[2U] = 0U;
+	b[0U] = b[1U] = b[2U] = 0U;
+	c[0U] = c[1U] = c[2U] = 0U;
+
+	unsigned int MASK = 0x800000U;
+	for (unsigned int i = 0U; i < 24U; i++) {
+		unsigned int a1Pos = DMR_A_TABLE[i];
+		unsigned int b1Pos = DMR_B_TABLE[i];
+		unsigned int c1Pos = DMR_C_TABLE[i];
+
+		unsigned int a2Pos = a1Pos + 72U;
+		if (a2Pos >= 108U)
+			a2Pos += 48U;
+		unsigned int b2Pos = b1Pos + 72U;
+		if (b2Pos >= 108U)
+			b2Pos += 48U;
+		unsigned int c2Pos = c1Pos + 72U;
+		if (c2Pos >= 108U)
+			c2Pos += 48U;
+
+		unsigned int a3Pos = a1Pos + 192U;
+		unsigned int b3Pos = b1Pos + 192U;
+		unsigned int c3Pos = c1Pos + 192U;
+
+		if (READ_BIT(bytes, a1Pos))
+			a[0U] |= MASK;
+		if (READ_BIT(bytes, a2Pos))
+			a[1U] |= MASK;
+		if (READ_BIT(bytes, a3Pos))
+			a[2U] |= MASK;
+		if (READ_BIT(bytes, b1Pos))
+			b[0U] |= MASK;
+		if (READ_BIT(bytes, b2Pos))
+			b[1U] |= MASK;
+		if (READ_BIT(bytes, b3Pos))
+			b[2U] |= MASK;
+		if (READ_BIT(bytes, c1Pos))
+			c[0U] |= MASK;
+		if (READ_BIT(bytes, c2Pos))
+			c[1U] |= MASK;
+		if (READ_BIT(bytes, c3Pos))
+			c[2U] |= MASK;
+
+		MASK >>= 1;
+	}
+}
+
+// The splice and table lookups of the new putDMR
+static void newSplit(const unsigned char* bytes, unsigned int* a, unsigned int* b, unsigned int* c)
+{
+	unsigned char frame[9U];
+	::memcpy(frame, bytes + 9U, 4U);
+	frame[4U] = (bytes[13U] & 0xF0U) | (bytes[19U] & 0x0FU);
+	::memcpy(frame + 5U, bytes + 20U, 4U);
+
+	CModeConv::decodeAMBE(bytes, a[0U], b[0U], c[0U]);
+	CModeConv::decodeAMBE(frame, a[1U], b[1U], c[1U]);
+	CModeConv::decodeAMBE(bytes + 24U, a[2U], b[2U], c[2U]);
+}
+
+// The loop of the old putAMBE2DMR
+static void oldJoin(unsigned int a, unsigned int b, unsigned int c, unsigned char* frame)
+{
+	unsigned int MASK = 0x800000U;
+	for (unsigned int i = 0U; i < 24U; i++) {
+		WRITE_BIT(frame, DMR_A_TABLE[i], a & MASK);
+		WRITE_BIT(frame, DMR_B_TABLE[i], b & MASK);
+		WRITE_BIT(frame, DMR_C_TABLE[i], c & MASK);
+
+		MASK >>= 1;
+	}
+}
+
+int main()
+{
+	unsigned int failures = 0U;
+
+	unsigned char bursts[BURSTS][33U];
+	unsigned int words[BURSTS][9U];
+	for (unsigned int i = 0U; i < BURSTS; i++) {
+		for (unsigned int j = 0U; j < 33U; j++)
+			bursts[i][j] = (unsigned char)::rand();
+		for (unsigned int j = 0U; j < 9U; j++)
+			words[i][j] = (unsigned int)::rand() & 0xFFFFFFU;
+	}
+
+	// Both must give the same words and frames
+	for (unsigned int i = 0U; i < BURSTS; i++) {
+		unsigned int a1[3U], b1[3U], c1[3U];
+		unsigned int a2[3U], b2[3U], c2[3U];
+		oldSplit(bursts[i], a1, b1, c1);
+		newSplit(bursts[i], a2, b2, c2);
+		if (::memcmp(a1, a2, sizeof(a1)) != 0 || ::memcmp(b1, b2, sizeof(b1)) != 0 || ::memcmp(c1, c2, sizeof(c1)) != 0)
+			failures++;
+
+		unsigned char frame1[9U], frame2[9U];
+		oldJoin(words[i][0U], words[i][1U], words[i][2U], frame1);
+		CModeConv::encodeAMBE(words[i][0U], words[i][1U], words[i][2U], frame2);
+		if (::memcmp(frame1, frame2, 9U) != 0)
+			failures++;
+	}
+
+	double oldSplitNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < BURSTS; i++) {
+			unsigned int a[3U], b[3U], c[3U];
+			oldSplit(bursts[i], a, b, c);
+			consume(a[0U] ^ b[1U] ^ c[2U]);
+		}
+	}, 100U) / double(BURSTS);
+
+	double newSplitNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < BURSTS; i++) {
+			unsigned int a[3U], b[3U], c[3U];
+			newSplit(bursts[i], a, b, c);
+			consume(a[0U] ^ b[1U] ^ c[2U]);
+		}
+	}, 100U) / double(BURSTS);
+
+	double oldJoinNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < BURSTS; i++) {
+			unsigned char frame[9U];
+			for (unsigned int j = 0U; j < 9U; j += 3U)
+				oldJoin(words[i][j + 0U], words[i][j + 1U], words[i][j + 2U], frame);
+			consume(frame[0U]);
+		}
+	}, 100U) / double(BURSTS);
+
+	double newJoinNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < BURSTS; i++) {
+			unsigned char frame[9U];
+			for (unsigned int j = 0U; j < 9U; j += 3U)
+				CModeConv::encodeAMBE(words[i][j + 0U], words[i][j + 1U], words[i][j + 2U], frame);
+			consume(frame[0U]);
+		}
+	}, 100U) / double(BURSTS);
+
+	::fprintf(stdout, "          old bursts/s  new bursts/s\n");
+	::fprintf(stdout, "split   %14.0f  %12.0f\n", 1.0E9 / oldSplitNs, 1.0E9 / newSplitNs);
+	::fprintf(stdout, "join    %14.0f  %12.0f\n", 1.0E9 / oldJoinNs, 1.0E9 / newJoinNs);
+
+	// Whole frames through the converter, five DMR bursts make three YSF frames
+	CModeConv conv;
+	unsigned char ysf[3U][155U];
+	for (unsigned int i = 0U; i < 3U; i++) {
+		for (unsigned int j = 0U; j < 155U; j++)
+			ysf[i][j] = (unsigned char)::rand();
+	}
+	unsigned char out[155U];
+
+	double dmrNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < 5U; i++)
+			conv.putDMR(bursts[i]);
+		while (conv.hasYSF())
+			consume(conv.getYSF(out));
+	}, 1000U) / 5.0;
+
+	double ysfNs = benchmark([&]() {
+		for (unsigned int i = 0U; i < 3U; i++)
+			conv.putYSF(ysf[i]);
+		while (conv.hasDMR())
+			consume(conv.getDMR(out));
+	}, 1000U) / 3.0;
+
+	::fprintf(stdout, "DMR to YSF %.0f bursts/s, YSF to DMR %.0f frames/s\n", 1.0E9 / dmrNs, 1.0E9 / ysfNs);
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u mismatches\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
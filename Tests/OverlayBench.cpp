@@ -0,0 +1,137 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares merging the precomputed EMB and Embedded LC bytes into voice
+// bursts B to F, as CYSF2DMR does, with encoding them for every burst
+// through CDMREmbeddedData and CDMREMB as it did before.
+
+#include "Bench.h"
+#include "DMREmbeddedData.h"
+#include "DMRDefines.h"
+#include "DMREMB.h"
+#include "DMRLC.h"
+
+#include <cstring>
+#include <cstdlib>
+
+const unsigned char COLOR_CODE = 1U;
+
+// As CYSF2DMR::createDMROverlays
+static void createOverlays(const CDMRLC& lc, unsigned char overlays[5U][7U])
+{
+	CDMREmbeddedData embeddedLC;
+	embeddedLC.setLC(lc);
+
+	CDMREMB emb;
+	emb.setColorCode(COLOR_CODE);
+
+	for (unsigned int n = 1U; n <= 5U; n++) {
+		unsigned char data[DMR_FRAME_LENGTH_BYTES];
+		::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+		unsigned char lcss = embeddedLC.getData(data, n);
+
+		emb.setLCSS(lcss);
+		emb.getData(data);
+
+		::memcpy(overlays[n - 1U], data + 13U, 7U);
+	}
+}
+
+// As CYSF2DMR::addDMROverlay
+static void addOverlay(const unsigned char overlays[5U][7U], unsigned char* data, unsigned int n)
+{
+	const unsigned char* overlay = overlays[n - 1U];
+
+	data[13U] = (data[13U] & 0xF0U) | overlay[0U];
+	::memcpy(data + 14U, overlay + 1U, 5U);
+	data[19U] = (data[19U] & 0x0FU) | overlay[6U];
+}
+
+// The encoding done for every burst before
+static void encodeBurst(const CDMREmbeddedData& embeddedLC, CDMREMB& emb, unsigned char* data, unsigned int n)
+{
+	unsigned char lcss = embeddedLC.getData(data, n);
+
+	emb.setLCSS(lcss);
+	emb.getData(data);
+}
+
+int main()
+{
+	unsigned int failures = 0U;
+
+	unsigned char bursts[5U][DMR_FRAME_LENGTH_BYTES];
+	for (unsigned int i = 0U; i < 5U; i++) {
+		for (unsigned int j = 0U; j < DMR_FRAME_LENGTH_BYTES; j++)
+			bursts[i][j] = (unsigned char)::rand();
+	}
+
+	CDMRLC lc(FLCO_GROUP, 2141234U, 9U);
+
+	CDMREmbeddedData embeddedLC;
+	embeddedLC.setLC(lc);
+
+	CDMREMB emb;
+	emb.setColorCode(COLOR_CODE);
+
+	unsigned char overlays[5U][7U];
+	createOverlays(lc, overlays);
+
+	// Both must give the same bursts, with the voice around the overlay untouched
+	for (unsigned int n = 1U; n <= 5U; n++) {
+		unsigned char data1[DMR_FRAME_LENGTH_BYTES], data2[DMR_FRAME_LENGTH_BYTES];
+		::memcpy(data1, bursts[n - 1U], DMR_FRAME_LENGTH_BYTES);
+		::memcpy(data2, bursts[n - 1U], DMR_FRAME_LENGTH_BYTES);
+
+		encodeBurst(embeddedLC, emb, data1, n);
+		addOverlay(overlays, data2, n);
+
+		if (::memcmp(data1, data2, DMR_FRAME_LENGTH_BYTES) != 0)
+			failures++;
+	}
+
+	double oldNs = benchmark([&]() {
+		for (unsigned int n = 1U; n <= 5U; n++) {
+			encodeBurst(embeddedLC, emb, bursts[n - 1U], n);
+			consume(bursts[n - 1U][13U]);
+		}
+	}, 10000U) / 5.0;
+
+	double newNs = benchmark([&]() {
+		for (unsigned int n = 1U; n <= 5U; n++) {
+			addOverlay(overlays, bursts[n - 1U], n);
+			consume(bursts[n - 1U][13U]);
+		}
+	}, 10000U) / 5.0;
+
+	double createNs = benchmark([&]() {
+		createOverlays(lc, overlays);
+		consume(overlays[0U][0U]);
+	}, 10000U);
+
+	::fprintf(stdout, "per burst        %.1f ns -> %.1f ns\n", oldNs, newNs);
+	::fprintf(stdout, "overlays per LC  %.1f ns\n", createNs);
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u mismatches\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
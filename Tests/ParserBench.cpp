@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares the throughput of CDMRIdParser with the fgets and strtok loop
+// it replaced, on generated files of 250000 Ids in both the DMRIds.dat
+// and the RadioID CSV formats. Both readers must give the same Ids.
+
+#include "Bench.h"
+#include "DMRIdParser.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <utility>
+
+typedef std::vector<std::pair<unsigned int, std::string> > ENTRIES;
+
+const unsigned int IDS = 250000U;
+
+const char* TEXT_FILE = "ParserBench.dat";
+const char* CSV_FILE  = "ParserBench.csv";
+
+// The reader before the rework
+static bool oldRead(const std::string& filename, ENTRIES& entries)
+{
+	FILE* fp = ::fopen(filename.c_str(), "rt");
+	if (fp == NULL)
+		return false;
+
+	char buffer[100U];
+	while (::fgets(buffer, 100U, fp) != NULL) {
+		if (buffer[0U] == '#')
+			continue;
+
+		char* p1 = ::strtok(buffer, " \t\r\n");
+		char* p2 = ::strtok(NULL, " \t\r\n");
+
+		if (p1 != NULL && p2 != NULL) {
+			unsigned int id = (unsigned int)::atoi(p1);
+			for (char* p = p2; *p != 0x00U; p++)
+				*p = ::toupper(*p);
+
+			entries.push_back(std::make_pair(id, std::string(p2)));
+		}
+	}
+
+	::fclose(fp);
+
+	return true;
+}
+
+static bool writeFiles(size_t& textLength, size_t& csvLength)
+{
+	FILE* text = ::fopen(TEXT_FILE, "wb");
+	FILE* csv  = ::fopen(CSV_FILE, "wb");
+	if (text == NULL || csv == NULL)
+		return false;
+
+	::fprintf(csv, "RADIO_ID,CALLSIGN,FIRST_NAME,LAST_NAME,CITY,STATE,COUNTRY\r\n");
+
+	for (unsigned int i = 0U; i < IDS; i++) {
+		unsigned int id = 1000000U + (unsigned int)::rand() % 8000000U;
+
+		char callsign[8U];
+		::sprintf(callsign, "%c%c%u%c%c%c", 'A' + ::rand() % 26, 'A' + ::rand() % 26, (unsigned int)::rand() % 10U,
+			'A' + ::rand() % 26, 'A' + ::rand() % 26, 'A' + ::rand() % 26);
+
+		::fprintf(text, "%u\t%s\tName\n", id, callsign);
+		::fprintf(csv, "%u,%s,Name,Surname,City,State,Country\r\n", id, callsign);
+	}
+
+	textLength = (size_t)::ftell(text);
+	csvLength  = (size_t)::ftell(csv);
+
+	::fclose(text);
+	::fclose(csv);
+
+	return true;
+}
+
+int main()
+{
+	size_t textLength, csvLength;
+	if (!writeFiles(textLength, csvLength)) {
+		::fprintf(stdout, "Cannot write the test files\n");
+		return 1;
+	}
+
+	unsigned int failures = 0U;
+
+	ENTRIES expected;
+	oldRead(TEXT_FILE, expected);
+
+	ENTRIES entries;
+	CDMRIdParser::read(TEXT_FILE, entries);
+	if (entries != expected)
+		failures++;
+
+	entries.clear();
+	CDMRIdParser::read(CSV_FILE, entries);
+	if (entries != expected)
+		failures++;
+
+	double oldNs = benchmark([&]() {
+		ENTRIES entries;
+		oldRead(TEXT_FILE, entries);
+		consume((unsigned int)entries.size());
+	}, 1U, 5U);
+
+	double textNs = benchmark([&]() {
+		ENTRIES entries;
+		CDMRIdParser::read(TEXT_FILE, entries);
+		consume((unsigned int)entries.size());
+	}, 1U, 5U);
+
+	double csvNs = benchmark([&]() {
+		ENTRIES entries;
+		CDMRIdParser::read(CSV_FILE, entries);
+		consume((unsigned int)entries.size());
+	}, 1U, 5U);
+
+	::remove(TEXT_FILE);
+	::remove(CSV_FILE);
+
+	::fprintf(stdout, "file  MB     old MB/s  new MB/s\n");
+	::fprintf(stdout, "text  %5.1f  %8.0f  %8.0f\n", textLength / 1.0E6, textLength / (oldNs / 1.0E3), textLength / (textNs / 1.0E3));
+	::fprintf(stdout, "csv   %5.1f            %8.0f\n", csvLength / 1.0E6, csvLength / (csvNs / 1.0E3));
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u mismatches\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
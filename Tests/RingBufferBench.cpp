@@ -0,0 +1,189 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares CRingBuffer with the element by element version it replaced,
+// for the 1000 byte buffers of CDelayBuffer and CYSFNetwork and the 5000
+// byte ones CModeConv used, with the record sizes that go through them.
+
+#include "Bench.h"
+#include "RingBuffer.h"
+
+#include <cstring>
+
+// The CRingBuffer before the rework
+template<class T> class COldRingBuffer {
+public:
+	COldRingBuffer(unsigned int length, const char* name) :
+	m_length(length),
+	m_name(name),
+	m_buffer(NULL),
+	m_iPtr(0U),
+	m_oPtr(0U)
+	{
+		m_buffer = new T[length];
+
+		::memset(m_buffer, 0x00, m_length * sizeof(T));
+	}
+
+	~COldRingBuffer()
+	{
+		delete[] m_buffer;
+	}
+
+	bool addData(const T* buffer, unsigned int nSamples)
+	{
+		if (nSamples >= freeSpace()) {
+			LogError("%s buffer overflow, clearing the buffer. (%u >= %u)", m_name, nSamples, freeSpace());
+			clear();
+			return false;
+		}
+
+		for (unsigned int i = 0U; i < nSamples; i++) {
+			m_buffer[m_iPtr++] = buffer[i];
+
+			if (m_iPtr == m_length)
+				m_iPtr = 0U;
+		}
+
+		return true;
+	}
+
+	bool getData(T* buffer, unsigned int nSamples)
+	{
+		if (dataSize() < nSamples) {
+			LogError("**** Underflow in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
+			return false;
+		}
+
+		for (unsigned int i = 0U; i < nSamples; i++) {
+			buffer[i] = m_buffer[m_oPtr++];
+
+			if (m_oPtr == m_length)
+				m_oPtr = 0U;
+		}
+
+		return true;
+	}
+
+	void clear()
+	{
+		m_iPtr = 0U;
+		m_oPtr = 0U;
+
+		::memset(m_buffer, 0x00, m_length * sizeof(T));
+	}
+
+	unsigned int freeSpace() const
+	{
+		unsigned int len = m_length;
+
+		if (m_oPtr > m_iPtr)
+			len = m_oPtr - m_iPtr;
+		else if (m_iPtr > m_oPtr)
+			len = m_length - (m_iPtr - m_oPtr);
+
+		if (len > m_length)
+			len = 0U;
+
+		return len;
+	}
+
+	unsigned int dataSize() const
+	{
+		return m_length - freeSpace();
+	}
+
+private:
+	unsigned int m_length;
+	const char*  m_name;
+	T*           m_buffer;
+	unsigned int m_iPtr;
+	unsigned int m_oPtr;
+};
+
+// Writes a few length prefixed records and reads them back, as CYSFNetwork does
+template<class B> unsigned int transfer(B& buffer, unsigned int record, unsigned int records, unsigned char* in, unsigned char* out)
+{
+	unsigned char len = (unsigned char)record;
+
+	for (unsigned int i = 0U; i < records; i++) {
+		buffer.addData(&len, 1U);
+		buffer.addData(in, record);
+		in[0U]++;
+	}
+
+	unsigned int sum = 0U;
+	for (unsigned int i = 0U; i < records; i++) {
+		buffer.getData(&len, 1U);
+		buffer.getData(out, len);
+		sum += out[0U] + out[len - 1U];
+	}
+
+	return sum;
+}
+
+int main()
+{
+	const unsigned int SIZES[]   = {1000U, 5000U};
+	const unsigned int RECORDS[] = {9U, 13U, 155U};
+
+	unsigned int failures = 0U;
+
+	::fprintf(stdout, "buffer  record  old ns/record  new ns/record\n");
+
+	for (unsigned int s = 0U; s < 2U; s++) {
+		for (unsigned int r = 0U; r < 3U; r++) {
+			unsigned int size   = SIZES[s];
+			unsigned int record = RECORDS[r];
+
+			// As many records as fit in half the buffer, so every pass crosses the wrap point somewhere
+			unsigned int records = (size / 2U) / (record + 1U);
+
+			unsigned char in[256U];
+			unsigned char out1[256U];
+			unsigned char out2[256U];
+			for (unsigned int i = 0U; i < 256U; i++)
+				in[i] = (unsigned char)(i * 37U);
+
+			COldRingBuffer<unsigned char> oldBuffer(size, "Old");
+			CRingBuffer<unsigned char>    newBuffer(size, "New");
+
+			// Both must give the same bytes back
+			for (unsigned int i = 0U; i < 1000U; i++) {
+				unsigned char in1[256U];
+				::memcpy(in1, in, 256U);
+				unsigned int sum1 = transfer(oldBuffer, record, records, in1, out1);
+				unsigned int sum2 = transfer(newBuffer, record, records, in, out2);
+				if (sum1 != sum2 || ::memcmp(out1, out2, record) != 0)
+					failures++;
+			}
+
+			double oldNs = benchmark([&]() { consume(transfer(oldBuffer, record, records, in, out1)); }, 1000U) / double(records);
+			double newNs = benchmark([&]() { consume(transfer(newBuffer, record, records, in, out2)); }, 1000U) / double(records);
+
+			::fprintf(stdout, "%6u  %6u  %13.1f  %13.1f\n", size, record, oldNs, newNs);
+		}
+	}
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u transfers differ\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Compares the Viterbi decoder of CYSFConvolution at each level this host
+// supports with the one it replaced, on FICH sized blocks of 100 steps
+// encoded from random data with some of the symbols flipped. The soft
+// decision decoder, given only certain symbols, must give the same bits.
+
+#include "Bench.h"
+#include "YSFConvolution.h"
+
+#include <cstring>
+#include <cstdlib>
+
+const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+
+const uint8_t BRANCH_TABLE1[] = {0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U};
+const uint8_t BRANCH_TABLE2[] = {0U, 1U, 1U, 0U, 0U, 1U, 1U, 0U};
+
+const unsigned int NUM_OF_STATES_D2 = 8U;
+const unsigned int NUM_OF_STATES = 16U;
+const uint32_t     M = 2U;
+const unsigned int K = 5U;
+
+const unsigned int BLOCKS = 64U;
+const unsigned int STEPS  = 100U;
+const unsigned int BITS   = 96U;
+
+// The decoder before the rework
+class COldConvolution {
+public:
+	COldConvolution() :
+	m_metrics1(NULL),
+	m_metrics2(NULL),
+	m_oldMetrics(NULL),
+	m_newMetrics(NULL),
+	m_decisions(NULL),
+	m_dp(NULL)
+	{
+		m_metrics1  = new uint16_t[16U];
+		m_metrics2  = new uint16_t[16U];
+		m_decisions = new uint64_t[180U];
+	}
+
+	~COldConvolution()
+	{
+		delete[] m_metrics1;
+		delete[] m_metrics2;
+		delete[] m_decisions;
+	}
+
+	void start()
+	{
+		::memset(m_metrics1, 0x00U, NUM_OF_STATES * sizeof(uint16_t));
+		::memset(m_metrics2, 0x00U, NUM_OF_STATES * sizeof(uint16_t));
+
+		m_oldMetrics = m_metrics1;
+		m_newMetrics = m_metrics2;
+		m_dp = m_decisions;
+	}
+
+	// Not inlined, as it was not when it lived in its own file
+	__attribute__((noinline)) void decode(uint8_t s0, uint8_t s1)
+	{
+		*m_dp = 0U;
+
+		for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
+			uint8_t j = i * 2U;
+
+			uint16_t metric = (BRANCH_TABLE1[i] ^ s0) + (BRANCH_TABLE2[i] ^ s1);
+
+			uint16_t m0 = m_oldMetrics[i] + metric;
+			uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
+			uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
+			m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+
+			m0 = m_oldMetrics[i] + (M - metric);
+			m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + metric;
+			uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
+			m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+
+			*m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
+		}
+
+		++m_dp;
+
+		uint16_t* tmp = m_oldMetrics;
+		m_oldMetrics = m_newMetrics;
+		m_newMetrics = tmp;
+	}
+
+	void chainback(unsigned char* out, unsigned int nBits)
+	{
+		uint32_t state = 0U;
+
+		while (nBits-- > 0) {
+			--m_dp;
+
+			uint32_t  i = state >> (9 - K);
+			uint8_t bit = uint8_t(*m_dp >> i) & 1;
+			state = (bit << 7) | (state >> 1);
+
+			WRITE_BIT1(out, nBits, bit != 0U);
+		}
+	}
+
+private:
+	uint16_t* m_metrics1;
+	uint16_t* m_metrics2;
+	uint16_t* m_oldMetrics;
+	uint16_t* m_newMetrics;
+	uint64_t* m_decisions;
+	uint64_t* m_dp;
+};
+
+template<class T> static void decodeBlock(T& viterbi, const unsigned char* symbols, unsigned char* out)
+{
+	viterbi.start();
+
+	for (unsigned int i = 0U; i < STEPS; i++)
+		viterbi.decode(READ_BIT1(symbols, i * 2U + 0U) ? 1U : 0U, READ_BIT1(symbols, i * 2U + 1U) ? 1U : 0U);
+
+	viterbi.chainback(out, BITS);
+}
+
+// The hard symbols as the most certain soft ones
+static void decodeSoftBlock(CYSFConvolution& viterbi, const unsigned char* symbols, unsigned char* out)
+{
+	viterbi.start();
+
+	for (unsigned int i = 0U; i < STEPS; i++)
+		viterbi.decodeSoft(READ_BIT1(symbols, i * 2U + 0U) ? VITERBI_SOFT_MAX : 0U, READ_BIT1(symbols, i * 2U + 1U) ? VITERBI_SOFT_MAX : 0U);
+
+	viterbi.chainback(out, BITS);
+}
+
+int main()
+{
+	unsigned int failures = 0U;
+
+	// Random data followed by the four zero bits that flush the encoder, with one symbol in twenty flipped
+	unsigned char symbols[BLOCKS][25U];
+	CYSFConvolution encoder;
+	for (unsigned int i = 0U; i < BLOCKS; i++) {
+		unsigned char data[13U];
+		::memset(data, 0x00U, 13U);
+		for (unsigned int j = 0U; j < 12U; j++)
+			data[j] = (unsigned char)::rand();
+
+		encoder.encode(data, symbols[i], STEPS);
+
+		for (unsigned int j = 0U; j < STEPS * 2U; j++) {
+			if ((::rand() % 20) == 0)
+				WRITE_BIT1(symbols[i], j, READ_BIT1(symbols[i], j) == 0U);
+		}
+	}
+
+	unsigned char expected[BLOCKS][12U];
+	COldConvolution oldViterbi;
+	for (unsigned int i = 0U; i < BLOCKS; i++)
+		decodeBlock(oldViterbi, symbols[i], expected[i]);
+
+	double oldNs = benchmark([&]() {
+		unsigned char out[12U];
+		for (unsigned int i = 0U; i < BLOCKS; i++) {
+			decodeBlock(oldViterbi, symbols[i], out);
+			consume(out[0U]);
+		}
+	}, 200U) / double(BLOCKS);
+
+	::fprintf(stdout, "level   decodes/s\n");
+	::fprintf(stdout, "old     %9.0f\n", 1.0E9 / oldNs);
+
+	const CPU_LEVEL LEVELS[] = {CPU_SCALAR, CPU_SSE2, CPU_BMI2, CPU_NEON};
+
+	CYSFConvolution newViterbi;
+	for (unsigned int l = 0U; l < 4U; l++) {
+		if (!CCPU::isSupported(LEVELS[l]))
+			continue;
+
+		CYSFConvolution::setLevel(LEVELS[l]);
+
+		// All must give the same bits
+		for (unsigned int i = 0U; i < BLOCKS; i++) {
+			unsigned char out[12U];
+			decodeBlock(newViterbi, symbols[i], out);
+			if (::memcmp(out, expected[i], 12U) != 0)
+				failures++;
+
+			decodeSoftBlock(newViterbi, symbols[i], out);
+			if (::memcmp(out, expected[i], 12U) != 0)
+				failures++;
+		}
+
+		double newNs = benchmark([&]() {
+			unsigned char out[12U];
+			for (unsigned int i = 0U; i < BLOCKS; i++) {
+				decodeBlock(newViterbi, symbols[i], out);
+				consume(out[0U]);
+			}
+		}, 200U) / double(BLOCKS);
+
+		::fprintf(stdout, "%-7s %9.0f\n", CCPU::getName(LEVELS[l]), 1.0E9 / newNs);
+	}
+
+	if (failures > 0U) {
+		::fprintf(stdout, "%u mismatches\n", failures);
+		return 1;
+	}
+
+	return 0;
+}
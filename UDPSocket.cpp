@@ -259,4 +259,11 @@ void CUDPSocket::close()
 #else
 	::close(m_fd);
 #endif
+
+	m_fd = -1;
+}
+
+int CUDPSocket::getFd() const
+{
+	return m_fd;
 }
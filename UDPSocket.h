@@ -47,6 +47,8 @@ public:
 
 	void close();
 
+	int  getFd() const;
+
 	static in_addr lookup(const std::string& hostName);
 
 private:
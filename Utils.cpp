@@ -16,6 +16,87 @@
 
 #include <cstdio>
 #include <cassert>
+#include <cstring>
+#include <cstdint>
+
+#if defined(CPU_X86_64)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define	BSWAP64(x)	_byteswap_uint64(x)
+#else
+#define	BSWAP64(x)	__builtin_bswap64(x)
+#endif
+#endif
+
+#if defined(CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static void byteToBitsBEScalar(unsigned char byte, bool* bits)
+{
+	bits[0U] = (byte & 0x80U) == 0x80U;
+	bits[1U] = (byte & 0x40U) == 0x40U;
+	bits[2U] = (byte & 0x20U) == 0x20U;
+	bits[3U] = (byte & 0x10U) == 0x10U;
+	bits[4U] = (byte & 0x08U) == 0x08U;
+	bits[5U] = (byte & 0x04U) == 0x04U;
+	bits[6U] = (byte & 0x02U) == 0x02U;
+	bits[7U] = (byte & 0x01U) == 0x01U;
+}
+
+static void bitsToByteBEScalar(const bool* bits, unsigned char& byte)
+{
+	byte  = bits[0U] ? 0x80U : 0x00U;
+	byte |= bits[1U] ? 0x40U : 0x00U;
+	byte |= bits[2U] ? 0x20U : 0x00U;
+	byte |= bits[3U] ? 0x10U : 0x00U;
+	byte |= bits[4U] ? 0x08U : 0x00U;
+	byte |= bits[5U] ? 0x04U : 0x00U;
+	byte |= bits[6U] ? 0x02U : 0x00U;
+	byte |= bits[7U] ? 0x01U : 0x00U;
+}
+
+#if defined(CPU_X86_64)
+// A bool is a byte holding 0 or 1, so eight of them are one word with a bit
+// at the bottom of each byte. The byte swap puts the first one at the top.
+CPU_TARGET("bmi2") static void byteToBitsBEBMI2(unsigned char byte, bool* bits)
+{
+	uint64_t word = BSWAP64(::_pdep_u64(byte, 0x0101010101010101ULL));
+	::memcpy(bits, &word, 8U);
+}
+
+CPU_TARGET("bmi2") static void bitsToByteBEBMI2(const bool* bits, unsigned char& byte)
+{
+	uint64_t word;
+	::memcpy(&word, bits, 8U);
+	byte = (unsigned char)::_pext_u64(BSWAP64(word), 0x0101010101010101ULL);
+}
+#endif
+
+#if defined(CPU_ARM_NEON)
+static void byteToBitsBENEON(unsigned char byte, bool* bits)
+{
+	static const uint8_t MASKS[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+	uint8x8_t set = vtst_u8(vdup_n_u8(byte), vld1_u8(MASKS));
+	vst1_u8((uint8_t*)bits, vand_u8(set, vdup_n_u8(1U)));
+}
+
+static void bitsToByteBENEON(const bool* bits, unsigned char& byte)
+{
+	static const int8_t SHIFTS[] = {7, 6, 5, 4, 3, 2, 1, 0};
+
+	// Every lane holds a different bit, so adding them up is the same as ORing them
+	uint8x8_t b = vshl_u8(vld1_u8((const uint8_t*)bits), vld1_s8(SHIFTS));
+	b = vpadd_u8(b, b);
+	b = vpadd_u8(b, b);
+	b = vpadd_u8(b, b);
+	byte = vget_lane_u8(b, 0);
+}
+#endif
+
+static void (*byteToBitsBEKernel)(unsigned char byte, bool* bits) = byteToBitsBEScalar;
+static void (*bitsToByteBEKernel)(const bool* bits, unsigned char& byte) = bitsToByteBEScalar;
 
 void CUtils::dump(const std::string& title, const unsigned char* data, unsigned int length)
 {
@@ -93,14 +174,7 @@ void CUtils::byteToBitsBE(unsigned char byte, bool* bits)
 {
 	assert(bits != NULL);
 
-	bits[0U] = (byte & 0x80U) == 0x80U;
-	bits[1U] = (byte & 0x40U) == 0x40U;
-	bits[2U] = (byte & 0x20U) == 0x20U;
-	bits[3U] = (byte & 0x10U) == 0x10U;
-	bits[4U] = (byte & 0x08U) == 0x08U;
-	bits[5U] = (byte & 0x04U) == 0x04U;
-	bits[6U] = (byte & 0x02U) == 0x02U;
-	bits[7U] = (byte & 0x01U) == 0x01U;
+	byteToBitsBEKernel(byte, bits);
 }
 
 void CUtils::byteToBitsLE(unsigned char byte, bool* bits)
@@ -121,14 +195,7 @@ void CUtils::bitsToByteBE(const bool* bits, unsigned char& byte)
 {
 	assert(bits != NULL);
 
-	byte  = bits[0U] ? 0x80U : 0x00U;
-	byte |= bits[1U] ? 0x40U : 0x00U;
-	byte |= bits[2U] ? 0x20U : 0x00U;
-	byte |= bits[3U] ? 0x10U : 0x00U;
-	byte |= bits[4U] ? 0x08U : 0x00U;
-	byte |= bits[5U] ? 0x04U : 0x00U;
-	byte |= bits[6U] ? 0x02U : 0x00U;
-	byte |= bits[7U] ? 0x01U : 0x00U;
+	bitsToByteBEKernel(bits, byte);
 }
 
 void CUtils::bitsToByteLE(const bool* bits, unsigned char& byte)
@@ -144,3 +211,25 @@ void CUtils::bitsToByteLE(const bool* bits, unsigned char& byte)
 	byte |= bits[6U] ? 0x40U : 0x00U;
 	byte |= bits[7U] ? 0x80U : 0x00U;
 }
+
+void CUtils::setLevel(CPU_LEVEL level)
+{
+	switch (level) {
+#if defined(CPU_X86_64)
+		case CPU_BMI2:
+			byteToBitsBEKernel = byteToBitsBEBMI2;
+			bitsToByteBEKernel = bitsToByteBEBMI2;
+			break;
+#endif
+#if defined(CPU_ARM_NEON)
+		case CPU_NEON:
+			byteToBitsBEKernel = byteToBitsBENEON;
+			bitsToByteBEKernel = bitsToByteBENEON;
+			break;
+#endif
+		default:
+			byteToBitsBEKernel = byteToBitsBEScalar;
+			bitsToByteBEKernel = bitsToByteBEScalar;
+			break;
+	}
+}
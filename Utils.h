@@ -14,6 +14,8 @@
 #ifndef	Utils_H
 #define	Utils_H
 
+#include "CPU.h"
+
 #include <string>
 
 class CUtils {
@@ -30,6 +32,9 @@ public:
 	static void bitsToByteBE(const bool* bits, unsigned char& byte);
 	static void bitsToByteLE(const bool* bits, unsigned char& byte);
 
+	// Selects the versions of byteToBitsBE and bitsToByteBE
+	static void setLevel(CPU_LEVEL level);
+
 private:
 };
 
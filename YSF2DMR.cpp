@@ -33,8 +33,20 @@
 const unsigned char dt1_temp[] = {0x34, 0x22, 0x62, 0x5F, 0x24, 0x53, 0x39, 0x54, 0x38, 0x38};
 const unsigned char dt2_temp[] = {0x52, 0x65, 0x2A, 0x3E, 0x6C, 0x22, 0x30, 0x20, 0x03, 0x8B};
 
-#define DMR_FRAME_PER       55U
-#define YSF_FRAME_PER       90U
+#define DMR_FRAME_PER       60U
+#define YSF_FRAME_PER       100U
+
+// Housekeeping tick of the event loop, fast while DMR data is being received
+#define IDLE_TICK_PER       1000U
+#define BUSY_TICK_PER       20U
+
+enum EVENT_ID {
+	EV_YSF_NETWORK,
+	EV_DMR_NETWORK,
+	EV_DMR_FRAME,
+	EV_YSF_FRAME,
+	EV_TICK
+};
 
 #if defined(_WIN32) || defined(_WIN64)
 const char* DEFAULT_INI_FILE = "YSF2DMR.ini";
@@ -45,19 +57,27 @@ const char* DEFAULT_INI_FILE = "/etc/YSF2DMR.ini";
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <cassert>
 #include <clocale>
 
 int main(int argc, char** argv)
 {
 	const char* iniFile = DEFAULT_INI_FILE;
+	CPU_LEVEL level = CCPU::probe();
 	if (argc > 1) {
 		for (int currentArg = 1; currentArg < argc; ++currentArg) {
 			std::string arg = argv[currentArg];
 			if ((arg == "-v") || (arg == "--version")) {
 				::fprintf(stdout, "YSF2DMR version %s\n", VERSION);
 				return 0;
+			} else if (arg.substr(0, 6) == "--cpu=") {
+				std::string name = arg.substr(6);
+				if (!CCPU::find(name, level) || !CCPU::isSupported(level)) {
+					::fprintf(stderr, "YSF2DMR: the %s kernels are not available, use one of: %s\n", name.c_str(), CCPU::getSupported().c_str());
+					return 1;
+				}
 			} else if (arg.substr(0, 1) == "-") {
-				::fprintf(stderr, "Usage: YSF2DMR [-v|--version] [filename]\n");
+				::fprintf(stderr, "Usage: YSF2DMR [-v|--version] [--cpu=<kernels>] [filename]\n");
 				return 1;
 			} else {
 				iniFile = argv[currentArg];
@@ -65,6 +85,8 @@ int main(int argc, char** argv)
 		}
 	}
 
+	CCPU::select(level);
+
 	CYSF2DMR* gateway = new CYSF2DMR(std::string(iniFile));
 
 	int ret = gateway->run();
@@ -78,14 +100,37 @@ CYSF2DMR::CYSF2DMR(const std::string& configFile) :
 m_callsign(),
 m_conf(configFile),
 m_dmrNetwork(NULL),
-m_dmrLastDT(0U)
+m_netSrc(YSF_CALLSIGN_LENGTH, ' '),
+m_netDst(YSF_CALLSIGN_LENGTH, ' '),
+m_dmrLastDT(0U),
+m_dmrflco(FLCO_GROUP),
+m_embeddedLC(),
+m_lcCache(16U),
+m_fichCache(64U),
+m_overlayFLCO(FLCO_GROUP),
+m_overlaySrcId(0U),
+m_overlayDstId(0U),
+m_ysfCnt(0U),
+m_dmrCnt(0U),
+m_ysfScheduler(NULL),
+m_dmrScheduler(NULL),
+m_dmrHeader(),
+m_dmrHeaders(0U),
+m_dmrFill(0U),
+m_dmrTerminator(false),
+m_networkWatchdog(100U, 0U, 1500U)
 {
 	::memset(m_ysfFrame, 0U, 200U);
 	::memset(m_dmrFrame, 0U, 50U);
+	::memset(m_dmrOverlays, 0U, 5U * 7U);
+
+	createYSFTemplates();
 }
 
 CYSF2DMR::~CYSF2DMR()
 {
+	delete m_ysfScheduler;
+	delete m_dmrScheduler;
 }
 
 int CYSF2DMR::run()
@@ -193,427 +238,487 @@ int CYSF2DMR::run()
 	m_lookup = new CDMRLookup(lookupFile, reloadTime);
 	m_lookup->read();
 
-	FLCO dmrflco;
 	if (m_dmrpc)
-		dmrflco = FLCO_USER_USER;
+		m_dmrflco = FLCO_USER_USER;
 	else
-		dmrflco = FLCO_GROUP;
+		m_dmrflco = FLCO_GROUP;
+
+	createDMROverlays();
 
-	CTimer networkWatchdog(100U, 0U, 1500U);
 	CTimer pollTimer(1000U, 5U);
 
 	CStopWatch stopWatch;
-	CStopWatch ysfWatch;
-	CStopWatch dmrWatch;
 	stopWatch.start();
-	ysfWatch.start();
-	dmrWatch.start();
 	pollTimer.start();
-	unsigned char ysf_cnt = 0;
-	unsigned char dmr_cnt = 0;
 
-	CDMREmbeddedData m_EmbeddedLC;
+	bool catchUp = m_conf.getCatchUp();
+	m_ysfScheduler = new CFrameScheduler("YSF", YSF_FRAME_PER, catchUp);
+	m_dmrScheduler = new CFrameScheduler("DMR", DMR_FRAME_PER, catchUp);
+
+	CEventLoop eventLoop;
+	bool useEventLoop = false;
 
 	LogMessage("Starting YSF2DMR-%s", VERSION);
+	LogMessage("Using the %s kernels, available: %s", CCPU::getName(CCPU::getSelected()), CCPU::getSupported().c_str());
+
+	if (m_conf.getEventLoop()) {
+		useEventLoop = eventLoop.open();
+		if (!useEventLoop)
+			LogWarning("The event loop is not available, falling back to polling");
+	}
 
 	for (;;) {
 		unsigned char buffer[2000U];
 		CDMRData tx_dmrdata;
 		unsigned int ms = stopWatch.elapsed();
 
-		while (m_ysfNetwork->read(buffer) > 0U) {
-			if (::memcmp(buffer, "YSFD", 4U) == 0U) {
-				CYSFFICH fich;
-
-				bool valid = fich.decode(buffer + 35U);
-				if (valid) {
-					unsigned char fi = fich.getFI();
-					unsigned char dt = fich.getDT();
-
-					CYSFPayload ysfPayload;
-
-					if (fi == YSF_FI_HEADER) {
-						if (ysfPayload.processHeaderData(buffer + 35U)) {
-							std::string ysfSrc = ysfPayload.getSource();
-							std::string ysfDst = ysfPayload.getDest();
-							LogMessage("Received YSF Header: Src: %s Dst: %s", ysfSrc.c_str(), ysfDst.c_str());
-							m_srcid = findYSFID(ysfSrc);
-							m_conv.putYSFHeader();
-						}
-					} else if (fi == YSF_FI_TERMINATOR) {
-						LogMessage("YSF received end of voice transmission");
-						m_conv.putYSFEOT();
-					} else if (fi == YSF_FI_COMMUNICATIONS) {
-						if (dt == YSF_DT_VD_MODE2)
-							m_conv.putYSF(buffer + 35U);
-						else if  (dt == YSF_DT_VD_MODE1)
-							LogMessage("YSF Mode V/D Type 1 not supported yet");
-					}
-				}
-			}
-		}
+		while (m_ysfNetwork->read(buffer) > 0U)
+			processYSF(buffer);
 
-		if (dmrWatch.elapsed() > DMR_FRAME_PER) {
-			unsigned int dmrFrameType = m_conv.getDMR(m_dmrFrame);
+		writeDMR();
 
-			if(dmrFrameType == TAG_HEADER) {
-				CDMRData rx_dmrdata;
-				dmr_cnt = 0U;
+		while (m_dmrNetwork->read(tx_dmrdata) > 0U) {
+			processDMR(tx_dmrdata);
+			watchDMR(tx_dmrdata, ms);
+		}
 
-				rx_dmrdata.setSlotNo(2U);
-				rx_dmrdata.setSrcId(m_srcid);
-				rx_dmrdata.setDstId(m_dstid);
-				rx_dmrdata.setFLCO(dmrflco);
-				rx_dmrdata.setN(0U);
-				rx_dmrdata.setSeqNo(0U);
-				rx_dmrdata.setBER(0U);
-				rx_dmrdata.setRSSI(0U);
-				rx_dmrdata.setDataType(DT_VOICE_LC_HEADER);
+		writeYSF();
 
-				// Add sync
-				CSync::addDMRDataSync(m_dmrFrame, 0);
+		stopWatch.start();
 
-				// Add SlotType
-				CDMRSlotType slotType;
-				slotType.setColorCode(m_colorcode);
-				slotType.setDataType(DT_VOICE_LC_HEADER);
-				slotType.getData(m_dmrFrame);
-	
-				// Full LC
-				CDMRLC dmrLC = CDMRLC(dmrflco, m_srcid, m_dstid);
-				CDMRFullLC fullLC;
-				fullLC.encode(dmrLC, m_dmrFrame, DT_VOICE_LC_HEADER);
-				m_EmbeddedLC.setLC(dmrLC);
-				
-				rx_dmrdata.setData(m_dmrFrame);
-				//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
-
-				for (unsigned int i = 0U; i < 3U; i++) {
-					rx_dmrdata.setSeqNo(dmr_cnt);
-					m_dmrNetwork->write(rx_dmrdata);
-					dmr_cnt++;
-				}
+		m_ysfNetwork->clock(ms);
+		m_dmrNetwork->clock(ms);
+		
+		pollTimer.clock(ms);
+		if (pollTimer.isRunning() && pollTimer.hasExpired()) {
+			m_ysfNetwork->writePoll();
+			pollTimer.start();
+		}
+
+		if (useEventLoop) {
+			eventLoop.setSocket(EV_YSF_NETWORK, m_ysfNetwork->getFd());
+			eventLoop.setSocket(EV_DMR_NETWORK, m_dmrNetwork->getFd());
 
-				dmrWatch.start();
+			// Only wake for the frame timers when there is something to send
+			if (hasDMRToSend()) {
+				unsigned int remaining = m_dmrScheduler->getRemaining();
+				eventLoop.setTimer(EV_DMR_FRAME, remaining > 0U ? remaining : 1U);
+			} else {
+				eventLoop.setTimer(EV_DMR_FRAME, 0U);
 			}
-			else if(dmrFrameType == TAG_EOT) {
-				CDMRData rx_dmrdata;
-				unsigned int n_dmr = (dmr_cnt - 3U) % 6U;
-				unsigned int fill = (6U - n_dmr);
-				
-				if (n_dmr) {
-					for (unsigned int i = 0U; i < fill; i++) {
-
-						CDMREMB emb;
-						CDMRData rx_dmrdata;
-
-						rx_dmrdata.setSlotNo(2U);
-						rx_dmrdata.setSrcId(m_srcid);
-						rx_dmrdata.setDstId(m_dstid);
-						rx_dmrdata.setFLCO(dmrflco);
-						rx_dmrdata.setN(n_dmr);
-						rx_dmrdata.setSeqNo(dmr_cnt);
-						rx_dmrdata.setBER(0U);
-						rx_dmrdata.setRSSI(0U);
-						rx_dmrdata.setDataType(DT_VOICE);
-
-						::memcpy(m_dmrFrame, DMR_SILENCE_DATA, DMR_FRAME_LENGTH_BYTES);
-
-						// Generate the Embedded LC
-						unsigned char lcss = m_EmbeddedLC.getData(m_dmrFrame, n_dmr);
-
-						// Generate the EMB
-						emb.setColorCode(m_colorcode);
-						emb.setLCSS(lcss);
-						emb.getData(m_dmrFrame);
-
-						rx_dmrdata.setData(m_dmrFrame);
-				
-						//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
-						m_dmrNetwork->write(rx_dmrdata);
-
-						n_dmr++;
-						dmr_cnt++;
-					}
-				}
 
-				rx_dmrdata.setSlotNo(2U);
-				rx_dmrdata.setSrcId(m_srcid);
-				rx_dmrdata.setDstId(m_dstid);
-				rx_dmrdata.setFLCO(dmrflco);
-				rx_dmrdata.setN(n_dmr);
-				rx_dmrdata.setSeqNo(dmr_cnt);
-				rx_dmrdata.setBER(0U);
-				rx_dmrdata.setRSSI(0U);
-				rx_dmrdata.setDataType(DT_TERMINATOR_WITH_LC);
+			if (m_conv.hasYSF()) {
+				unsigned int remaining = m_ysfScheduler->getRemaining();
+				eventLoop.setTimer(EV_YSF_FRAME, remaining > 0U ? remaining : 1U);
+			} else {
+				eventLoop.setTimer(EV_YSF_FRAME, 0U);
+			}
 
-				// Add sync
-				CSync::addDMRDataSync(m_dmrFrame, 0);
+			// The DMR jitter buffer is emptied by time, not by socket activity
+			eventLoop.setTimer(EV_TICK, m_dmrNetwork->hasData() ? BUSY_TICK_PER : IDLE_TICK_PER);
 
-				// Add SlotType
-				CDMRSlotType slotType;
-				slotType.setColorCode(m_colorcode);
-				slotType.setDataType(DT_TERMINATOR_WITH_LC);
-				slotType.getData(m_dmrFrame);
-	
-				// Full LC
-				CDMRLC dmrLC = CDMRLC(dmrflco, m_srcid, m_dstid);
-				CDMRFullLC fullLC;
-				fullLC.encode(dmrLC, m_dmrFrame, DT_TERMINATOR_WITH_LC);
-				
-				rx_dmrdata.setData(m_dmrFrame);
-				//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
-				m_dmrNetwork->write(rx_dmrdata);
-
-				dmrWatch.start();
-			}
-			else if(dmrFrameType == TAG_DATA) {
-				CDMREMB emb;
-				CDMRData rx_dmrdata;
-				unsigned int n_dmr = (dmr_cnt - 3U) % 6U;
-
-				rx_dmrdata.setSlotNo(2U);
-				rx_dmrdata.setSrcId(m_srcid);
-				rx_dmrdata.setDstId(m_dstid);
-				rx_dmrdata.setFLCO(dmrflco);
-				rx_dmrdata.setN(n_dmr);
-				rx_dmrdata.setSeqNo(dmr_cnt);
-				rx_dmrdata.setBER(0U);
-				rx_dmrdata.setRSSI(0U);
-			
-				if (!n_dmr) {
-					rx_dmrdata.setDataType(DT_VOICE_SYNC);
-					// Add sync
-					CSync::addDMRAudioSync(m_dmrFrame, 0U);
-					// Prepare Full LC data
-					CDMRLC dmrLC = CDMRLC(dmrflco, m_srcid, m_dstid);
-					// Configure the Embedded LC
-					m_EmbeddedLC.setLC(dmrLC);
-				}
-				else {
-					rx_dmrdata.setDataType(DT_VOICE);
-					// Generate the Embedded LC
-					unsigned char lcss = m_EmbeddedLC.getData(m_dmrFrame, n_dmr);
-					// Generate the EMB
-					emb.setColorCode(m_colorcode);
-					emb.setLCSS(lcss);
-					emb.getData(m_dmrFrame);
-				}
+			unsigned int events = eventLoop.wait();
 
-				rx_dmrdata.setData(m_dmrFrame);
-				
-				//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
-				m_dmrNetwork->write(rx_dmrdata);
+			// Pull the datagrams in now so that they are handled on this wake up
+			if ((events & (1U << EV_YSF_NETWORK)) != 0U)
+				m_ysfNetwork->clock(0U);
 
-				dmr_cnt++;
-				dmrWatch.start();
-			}
+			if ((events & (1U << EV_DMR_NETWORK)) != 0U)
+				m_dmrNetwork->clock(0U);
+		} else if (ms < 5U) {
+			CThread::sleep(5U);
 		}
+	}
 
-		while (m_dmrNetwork->read(tx_dmrdata) > 0U) {
-			unsigned int SrcId = tx_dmrdata.getSrcId();
-			unsigned int DstId = tx_dmrdata.getDstId();
-			FLCO netflco = tx_dmrdata.getFLCO();
-			unsigned char DataType = tx_dmrdata.getDataType();
-
-			if (!tx_dmrdata.isMissing()) {
-				networkWatchdog.start();
-
-				if(DataType == DT_TERMINATOR_WITH_LC) {
-					LogMessage("DMR received end of voice transmission");
-					m_conv.putDMREOT();
-					m_dmrNetwork->reset(2U);
-					networkWatchdog.stop();
-				}
+	eventLoop.close();
 
-				if((DataType == DT_VOICE_LC_HEADER) && (DataType != m_dmrLastDT)) {
-					m_netSrc = m_lookup->findCS(SrcId);
-					m_netDst = (netflco == FLCO_GROUP ? "TG " : "") + m_lookup->findCS(DstId);
+	m_ysfNetwork->close();
+	m_dmrNetwork->close();
 
-					m_conv.putDMRHeader();
-					LogMessage("DMR Header received from %s to %s", m_netSrc.c_str(), m_netDst.c_str());
+	delete m_dmrNetwork;
+	delete m_ysfNetwork;
 
-					m_netSrc.resize(YSF_CALLSIGN_LENGTH, ' ');
-					m_netDst.resize(YSF_CALLSIGN_LENGTH, ' ');
-				}
+	::LogFinalise();
 
-				if(DataType == DT_VOICE_SYNC || DataType == DT_VOICE) {
-					unsigned char dmr_frame[50];
-					tx_dmrdata.getData(dmr_frame);
-					m_conv.putDMR(dmr_frame); // Add DMR frame for YSF conversion
-				}
-			}
-			else {
-				if(DataType == DT_VOICE_SYNC || DataType == DT_VOICE) {
-					unsigned char dmr_frame[50];
-					tx_dmrdata.getData(dmr_frame);
-					m_conv.putDMR(dmr_frame); // Add DMR frame for YSF conversion
-				}
+	return 0;
+}
 
-				networkWatchdog.clock(ms);
-				if (networkWatchdog.hasExpired()) {
-					LogDebug("Network watchdog has expired");
-					m_dmrNetwork->reset(2U);
-					networkWatchdog.stop();
+void CYSF2DMR::processYSF(unsigned char* buffer)
+{
+	if (::memcmp(buffer, "YSFD", 4U) == 0U) {
+		CYSFFICH fich;
+
+		bool valid = m_fichCache.decode(buffer + 35U, fich);
+		if (valid) {
+			unsigned char fi = fich.getFI();
+			unsigned char dt = fich.getDT();
+
+			CYSFPayload ysfPayload;
+
+			if (fi == YSF_FI_HEADER) {
+				if (ysfPayload.readHeaderData(buffer + 35U)) {
+					std::string ysfSrc = ysfPayload.getSource();
+					std::string ysfDst = ysfPayload.getDest();
+					LogMessage("Received YSF Header: Src: %s Dst: %s", ysfSrc.c_str(), ysfDst.c_str());
+					m_srcid = findYSFID(ysfSrc);
+					m_conv.putYSFHeader();
 				}
+			} else if (fi == YSF_FI_TERMINATOR) {
+				LogMessage("YSF received end of voice transmission");
+				m_fichCache.report();
+				m_conv.putYSFEOT();
+			} else if (fi == YSF_FI_COMMUNICATIONS) {
+				if (dt == YSF_DT_VD_MODE2)
+					m_conv.putYSF(buffer + 35U);
+				else if  (dt == YSF_DT_VD_MODE1)
+					LogMessage("YSF Mode V/D Type 1 not supported yet");
 			}
+		}
+	}
+}
+
+void CYSF2DMR::processDMR(const CDMRData& data)
+{
+	unsigned int SrcId = data.getSrcId();
+	unsigned int DstId = data.getDstId();
+	FLCO netflco = data.getFLCO();
+	unsigned char DataType = data.getDataType();
+
+	if (!data.isMissing()) {
+		if(DataType == DT_TERMINATOR_WITH_LC) {
+			LogMessage("DMR received end of voice transmission");
+			m_conv.putDMREOT();
+		}
+
+		if((DataType == DT_VOICE_LC_HEADER) && (DataType != m_dmrLastDT)) {
+			m_netSrc = m_lookup->findCS(SrcId);
+			m_netDst = (netflco == FLCO_GROUP ? "TG " : "") + m_lookup->findCS(DstId);
+
+			m_conv.putDMRHeader();
+			LogMessage("DMR Header received from %s to %s", m_netSrc.c_str(), m_netDst.c_str());
+
+			m_netSrc.resize(YSF_CALLSIGN_LENGTH, ' ');
+			m_netDst.resize(YSF_CALLSIGN_LENGTH, ' ');
+
+			createYSFTemplates();
+		}
+	}
+
+	if(DataType == DT_VOICE_SYNC || DataType == DT_VOICE) {
+		unsigned char dmr_frame[50];
+		data.getData(dmr_frame);
+		m_conv.putDMR(dmr_frame); // Add DMR frame for YSF conversion
+	}
+
+	m_dmrLastDT = DataType;
+}
+
+void CYSF2DMR::watchDMR(const CDMRData& data, unsigned int ms)
+{
+	if (!data.isMissing()) {
+		m_networkWatchdog.start();
+
+		if (data.getDataType() == DT_TERMINATOR_WITH_LC) {
+			m_dmrNetwork->reset(2U);
+			m_networkWatchdog.stop();
+		}
+	} else {
+		m_networkWatchdog.clock(ms);
+		if (m_networkWatchdog.hasExpired()) {
+			LogDebug("Network watchdog has expired");
+			m_dmrNetwork->reset(2U);
+			m_networkWatchdog.stop();
+		}
+	}
+}
+
+void CYSF2DMR::writeDMR()
+{
+	if (m_dmrHeaders > 0U && m_dmrScheduler->isDue()) {
+		m_dmrHeader.setSeqNo(m_dmrCnt);
+		m_dmrNetwork->write(m_dmrHeader);
+		m_dmrCnt++;
+		m_dmrHeaders--;
+
+		m_dmrScheduler->sent();
+	} else if ((m_dmrFill > 0U || m_dmrTerminator) && m_dmrScheduler->isDue()) {
+		writeDMREnd();
+	} else if (m_dmrScheduler->isDue()) {
+		unsigned int dmrFrameType = m_conv.getDMR(m_dmrFrame);
+
+		if(dmrFrameType == TAG_HEADER) {
+			CDMRData rx_dmrdata;
+			m_dmrCnt = 0U;
+
+			rx_dmrdata.setSlotNo(2U);
+			rx_dmrdata.setSrcId(m_srcid);
+			rx_dmrdata.setDstId(m_dstid);
+			rx_dmrdata.setFLCO(m_dmrflco);
+			rx_dmrdata.setN(0U);
+			rx_dmrdata.setSeqNo(0U);
+			rx_dmrdata.setBER(0U);
+			rx_dmrdata.setRSSI(0U);
+			rx_dmrdata.setDataType(DT_VOICE_LC_HEADER);
+
+			// Sync, SlotType and Full LC
+			m_lcCache.getData(m_dmrflco, m_srcid, m_dstid, m_colorcode, DT_VOICE_LC_HEADER, m_dmrFrame);
+
+			createDMROverlays();
 			
-			m_dmrLastDT = DataType;
+			rx_dmrdata.setData(m_dmrFrame);
+			//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+
+			m_dmrNetwork->write(rx_dmrdata);
+			m_dmrCnt++;
+
+			m_dmrHeader = rx_dmrdata;
+			m_dmrHeaders = 2U;
+
+			m_dmrScheduler->start();
+			m_dmrScheduler->sent();
+		}
+		else if(dmrFrameType == TAG_EOT) {
+			// Silence fills up the superframe, then the terminator follows, one burst per slot
+			unsigned int n_dmr = (m_dmrCnt - 3U) % 6U;
+			m_dmrFill = n_dmr ? 6U - n_dmr : 0U;
+			m_dmrTerminator = true;
+
+			writeDMREnd();
 		}
+		else if(dmrFrameType == TAG_DATA) {
+			CDMRData rx_dmrdata;
+			unsigned int n_dmr = (m_dmrCnt - 3U) % 6U;
+
+			rx_dmrdata.setSlotNo(2U);
+			rx_dmrdata.setSrcId(m_srcid);
+			rx_dmrdata.setDstId(m_dstid);
+			rx_dmrdata.setFLCO(m_dmrflco);
+			rx_dmrdata.setN(n_dmr);
+			rx_dmrdata.setSeqNo(m_dmrCnt);
+			rx_dmrdata.setBER(0U);
+			rx_dmrdata.setRSSI(0U);
 		
-		if (ysfWatch.elapsed() > YSF_FRAME_PER) {
-			unsigned int ysfFrameType = m_conv.getYSF(m_ysfFrame + 35U);
-
-			if(ysfFrameType == TAG_HEADER) {
-				ysf_cnt = 0U;
-
-				::memcpy(m_ysfFrame + 0U, "YSFD", 4U);
-				::memcpy(m_ysfFrame + 4U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 14U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 24U, "ALL       ", YSF_CALLSIGN_LENGTH);
-				m_ysfFrame[34U] = 0U; // Net frame counter
-
-				CSync::addYSFSync(m_ysfFrame + 35U);
-
-				// Set the FICH
-				CYSFFICH fich;
-				fich.setFI(YSF_FI_HEADER);
-				fich.setCS(2U);
-				fich.setFN(0U);
-				fich.setFT(7U);
-				fich.setDev(0U);
-				fich.setMR(2U);
-				fich.setDT(YSF_DT_VD_MODE2);
-				fich.setSQL(0U);
-				fich.setSQ(0U);
-				fich.encode(m_ysfFrame + 35U);
-
-				unsigned char csd1[20U], csd2[20U];
-				memset(csd1, '*', YSF_CALLSIGN_LENGTH);
-				memcpy(csd1 + YSF_CALLSIGN_LENGTH, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				memset(csd2, ' ', YSF_CALLSIGN_LENGTH + YSF_CALLSIGN_LENGTH);
-
-				CYSFPayload payload;
-				payload.writeHeader(m_ysfFrame + 35U, csd1, csd2);
-
-				m_ysfNetwork->write(m_ysfFrame);
-				
-				ysf_cnt++;
-				ysfWatch.start();
-			}
-			else if (ysfFrameType == TAG_EOT) {
-				::memcpy(m_ysfFrame + 0U, "YSFD", 4U);
-				::memcpy(m_ysfFrame + 4U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 14U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 24U, "ALL       ", YSF_CALLSIGN_LENGTH);
-				m_ysfFrame[34U] = ysf_cnt; // Net frame counter
-
-				CSync::addYSFSync(m_ysfFrame + 35U);
-
-				// Set the FICH
-				CYSFFICH fich;
-				fich.setFI(YSF_FI_TERMINATOR);
-				fich.setCS(2U);
-				fich.setFN(0U);
-				fich.setFT(7U);
-				fich.setDev(0U);
-				fich.setMR(2U);
-				fich.setDT(YSF_DT_VD_MODE2);
-				fich.setSQL(0U);
-				fich.setSQ(0U);
-				fich.encode(m_ysfFrame + 35U);
-
-				unsigned char csd1[20U], csd2[20U];
-				memset(csd1, '*', YSF_CALLSIGN_LENGTH);
-				memcpy(csd1 + YSF_CALLSIGN_LENGTH, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				memset(csd2, ' ', YSF_CALLSIGN_LENGTH + YSF_CALLSIGN_LENGTH);
-
-				CYSFPayload payload;
-				payload.writeHeader(m_ysfFrame + 35U, csd1, csd2);
-
-				m_ysfNetwork->write(m_ysfFrame);
+			if (!n_dmr) {
+				rx_dmrdata.setDataType(DT_VOICE_SYNC);
+				// Add sync
+				CSync::addDMRAudioSync(m_dmrFrame, 0U);
+				// The Embedded LC only needs encoding again if the LC has changed
+				if (m_dmrflco != m_overlayFLCO || m_srcid != m_overlaySrcId || m_dstid != m_overlayDstId)
+					createDMROverlays();
 			}
-			else if (ysfFrameType == TAG_DATA) {
-				CYSFFICH fich;
-				CYSFPayload ysfPayload;
-
-				unsigned int fn = (ysf_cnt - 1U) % 8U;
-
-				::memcpy(m_ysfFrame + 0U, "YSFD", 4U);
-				::memcpy(m_ysfFrame + 4U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 14U, m_ysfNetwork->getCallsign().c_str(), YSF_CALLSIGN_LENGTH);
-				::memcpy(m_ysfFrame + 24U, "ALL       ", YSF_CALLSIGN_LENGTH);
-
-				// Add the YSF Sync
-				CSync::addYSFSync(m_ysfFrame + 35U);
-
-				switch (fn) {
-					case 0:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, (const unsigned char*)"**********");
-						break;
-					case 1:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, (const unsigned char*)m_netSrc.c_str());
-						break;
-					case 2:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, (const unsigned char*)m_netDst.c_str());
-						break;
-					case 6:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, dt1_temp);
-						break;
-					case 7:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, dt2_temp);
-						break;
-					default:
-						ysfPayload.writeVDMode2Data(m_ysfFrame + 35U, (const unsigned char*)"          ");
-				}
-				
-				// Set the FICH
-				fich.setFI(YSF_FI_COMMUNICATIONS);
-				fich.setCS(2U);
-				fich.setFN(fn);
-				fich.setFT(7U);
-				fich.setDev(0U);
-				fich.setMR(YSF_MR_BUSY);
-				fich.setDT(YSF_DT_VD_MODE2);
-				fich.setSQL(0U);
-				fich.setSQ(0U);
-				fich.encode(m_ysfFrame + 35U);
-
-				// Net frame counter
-				m_ysfFrame[34U] = (ysf_cnt & 0x7FU) << 1;
-
-				// Send data to MMDVMHost
-				m_ysfNetwork->write(m_ysfFrame);
-				
-				ysf_cnt++;
-				ysfWatch.start();
+			else {
+				rx_dmrdata.setDataType(DT_VOICE);
+				// Add the EMB and the Embedded LC
+				addDMROverlay(m_dmrFrame, n_dmr);
 			}
-		}
 
-		stopWatch.start();
+			rx_dmrdata.setData(m_dmrFrame);
+			
+			//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+			m_dmrNetwork->write(rx_dmrdata);
 
-		m_ysfNetwork->clock(ms);
-		m_dmrNetwork->clock(ms);
-		
-		pollTimer.clock(ms);
-		if (pollTimer.isRunning() && pollTimer.hasExpired()) {
-			m_ysfNetwork->writePoll();
-			pollTimer.start();
+			m_dmrCnt++;
+			m_dmrScheduler->sent();
 		}
+		else
+			m_dmrScheduler->underrun();
+	}
+}
 
-		if (ms < 5U)
-			CThread::sleep(5U);
+// Sends the next silence burst of the end of a transmission, or when they
+// are all gone the terminator
+void CYSF2DMR::writeDMREnd()
+{
+	CDMRData rx_dmrdata;
+	unsigned int n_dmr = (m_dmrCnt - 3U) % 6U;
+
+	rx_dmrdata.setSlotNo(2U);
+	rx_dmrdata.setSrcId(m_srcid);
+	rx_dmrdata.setDstId(m_dstid);
+	rx_dmrdata.setFLCO(m_dmrflco);
+	rx_dmrdata.setN(n_dmr);
+	rx_dmrdata.setSeqNo(m_dmrCnt);
+	rx_dmrdata.setBER(0U);
+	rx_dmrdata.setRSSI(0U);
+
+	if (m_dmrFill > 0U) {
+		rx_dmrdata.setDataType(DT_VOICE);
+
+		::memcpy(m_dmrFrame, DMR_SILENCE_DATA, DMR_FRAME_LENGTH_BYTES);
+
+		// Add the EMB and the Embedded LC
+		addDMROverlay(m_dmrFrame, n_dmr);
+
+		rx_dmrdata.setData(m_dmrFrame);
+
+		//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+		m_dmrNetwork->write(rx_dmrdata);
+
+		m_dmrCnt++;
+		m_dmrFill--;
+
+		m_dmrScheduler->sent();
+	} else {
+		rx_dmrdata.setDataType(DT_TERMINATOR_WITH_LC);
+
+		// Sync, SlotType and Full LC
+		m_lcCache.getData(m_dmrflco, m_srcid, m_dstid, m_colorcode, DT_TERMINATOR_WITH_LC, m_dmrFrame);
+
+		rx_dmrdata.setData(m_dmrFrame);
+		//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+		m_dmrNetwork->write(rx_dmrdata);
+
+		m_dmrTerminator = false;
+
+		m_dmrScheduler->sent();
+		m_dmrScheduler->stop();
+		LogDebug("DMR frames waited up to %ums in the converter", m_conv.getDMRLatency());
 	}
+}
 
-	m_ysfNetwork->close();
-	m_dmrNetwork->close();
+// Bytes 13 to 19 of voice bursts B to F carry the EMB and a fragment of
+// the Embedded LC. Both only depend on the LC and the colour code, so the
+// five fragments are encoded once per LC and then merged into each burst.
+void CYSF2DMR::createDMROverlays()
+{
+	CDMRLC dmrLC = CDMRLC(m_dmrflco, m_srcid, m_dstid);
+	m_embeddedLC.setLC(dmrLC);
 
-	delete m_dmrNetwork;
-	delete m_ysfNetwork;
+	CDMREMB emb;
+	emb.setColorCode(m_colorcode);
 
-	::LogFinalise();
+	for (unsigned int n = 1U; n <= 5U; n++) {
+		unsigned char data[DMR_FRAME_LENGTH_BYTES];
+		::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
 
-	return 0;
+		unsigned char lcss = m_embeddedLC.getData(data, n);
+
+		emb.setLCSS(lcss);
+		emb.getData(data);
+
+		::memcpy(m_dmrOverlays[n - 1U], data + 13U, 7U);
+	}
+
+	m_overlayFLCO  = m_dmrflco;
+	m_overlaySrcId = m_srcid;
+	m_overlayDstId = m_dstid;
+}
+
+void CYSF2DMR::addDMROverlay(unsigned char* data, unsigned int n) const
+{
+	assert(data != NULL);
+	assert(n >= 1U && n <= 5U);
+
+	const unsigned char* overlay = m_dmrOverlays[n - 1U];
+
+	data[13U] = (data[13U] & 0xF0U) | overlay[0U];
+	::memcpy(data + 14U, overlay + 1U, 5U);
+	data[19U] = (data[19U] & 0x0FU) | overlay[6U];
+}
+
+void CYSF2DMR::writeYSF()
+{
+	if (m_ysfScheduler->isDue()) {
+		unsigned int ysfFrameType = m_conv.getYSF(m_ysfFrame + 35U);
+
+		if(ysfFrameType == TAG_HEADER) {
+			m_ysfCnt = 0U;
+
+			::memcpy(m_ysfFrame, m_ysfNetwork->getHeader(), YSF_PACKET_LENGTH);
+			m_ysfFrame[34U] = 0U; // Net frame counter
+
+			m_ysfNetwork->write(m_ysfFrame);
+			
+			m_ysfCnt++;
+			m_ysfScheduler->start();
+			m_ysfScheduler->sent();
+		}
+		else if (ysfFrameType == TAG_EOT) {
+			::memcpy(m_ysfFrame, m_ysfNetwork->getTerminator(), YSF_PACKET_LENGTH);
+			m_ysfFrame[34U] = m_ysfCnt; // Net frame counter
+
+			m_ysfNetwork->write(m_ysfFrame);
+
+			m_ysfScheduler->sent();
+			m_ysfScheduler->stop();
+			LogDebug("YSF frames waited up to %ums in the converter", m_conv.getYSFLatency());
+		}
+		else if (ysfFrameType == TAG_DATA) {
+			unsigned int fn = (m_ysfCnt - 1U) % 8U;
+
+			// Gateway and callsigns, the same as in the header
+			::memcpy(m_ysfFrame, m_ysfNetwork->getHeader(), 34U);
+
+			// Sync, FICH and the five DCH sections around the VCH sections
+			const unsigned char* tmpl = m_ysfTemplates[fn];
+			::memcpy(m_ysfFrame + 35U, tmpl, YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES);
+			for (unsigned int i = YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES; i < YSF_FRAME_LENGTH_BYTES; i += 18U)
+				::memcpy(m_ysfFrame + 35U + i, tmpl + i, 5U);
+
+			// Net frame counter
+			m_ysfFrame[34U] = (m_ysfCnt & 0x7FU) << 1;
+
+			// Send data to MMDVMHost
+			m_ysfNetwork->write(m_ysfFrame);
+			
+			m_ysfCnt++;
+			m_ysfScheduler->sent();
+		}
+		else
+			m_ysfScheduler->underrun();
+	}
+}
+
+// The sync, FICH and DCH of a V/D mode 2 frame only depend on the frame
+// number within the superframe and on the callsigns of the call, so they
+// are encoded once per call rather than once per frame.
+void CYSF2DMR::createYSFTemplates()
+{
+	CYSFFICH fich;
+	fich.setFI(YSF_FI_COMMUNICATIONS);
+	fich.setCS(2U);
+	fich.setFT(7U);
+	fich.setDev(0U);
+	fich.setMR(YSF_MR_BUSY);
+	fich.setDT(YSF_DT_VD_MODE2);
+	fich.setSQL(0U);
+	fich.setSQ(0U);
+
+	CYSFPayload ysfPayload;
+
+	for (unsigned int fn = 0U; fn < 8U; fn++) {
+		unsigned char* tmpl = m_ysfTemplates[fn];
+		::memset(tmpl, 0x00U, YSF_FRAME_LENGTH_BYTES);
+
+		CSync::addYSFSync(tmpl);
+
+		switch (fn) {
+			case 0:
+				ysfPayload.writeVDMode2Data(tmpl, (const unsigned char*)"**********");
+				break;
+			case 1:
+				ysfPayload.writeVDMode2Data(tmpl, (const unsigned char*)m_netSrc.c_str());
+				break;
+			case 2:
+				ysfPayload.writeVDMode2Data(tmpl, (const unsigned char*)m_netDst.c_str());
+				break;
+			case 6:
+				ysfPayload.writeVDMode2Data(tmpl, dt1_temp);
+				break;
+			case 7:
+				ysfPayload.writeVDMode2Data(tmpl, dt2_temp);
+				break;
+			default:
+				ysfPayload.writeVDMode2Data(tmpl, (const unsigned char*)"          ");
+		}
+
+		fich.setFN(fn);
+		fich.encode(tmpl);
+	}
+}
+bool CYSF2DMR::hasDMRToSend()
+{
+	return m_dmrHeaders > 0U || m_dmrFill > 0U || m_dmrTerminator || m_conv.hasDMR();
 }
 
 unsigned int CYSF2DMR::findYSFID(std::string cs)
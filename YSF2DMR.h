@@ -28,17 +28,22 @@
 #include "DMRFullLC.h"
 #include "DMREMB.h"
 #include "DMRLookup.h"
+#include "DMRLCCache.h"
+#include "EventLoop.h"
+#include "FrameScheduler.h"
 #include "UDPSocket.h"
 #include "StopWatch.h"
 #include "Version.h"
 #include "YSFPayload.h"
 #include "YSFNetwork.h"
 #include "YSFFICH.h"
+#include "YSFFICHCache.h"
 #include "Thread.h"
 #include "Timer.h"
 #include "Sync.h"
 #include "Utils.h"
 #include "Conf.h"
+#include "CPU.h"
 #include "Log.h"
 
 #include <string>
@@ -68,10 +73,39 @@ private:
 	std::string    m_netDst;
 	unsigned char  m_dmrLastDT;
 	unsigned char  m_ysfFrame[200U];
+	unsigned char  m_ysfTemplates[8U][YSF_FRAME_LENGTH_BYTES];
 	unsigned char  m_dmrFrame[50U];
-	
+	FLCO           m_dmrflco;
+	CDMREmbeddedData m_embeddedLC;
+	CDMRLCCache    m_lcCache;
+	CYSFFICHCache  m_fichCache;
+	unsigned char  m_dmrOverlays[5U][7U];
+	FLCO           m_overlayFLCO;
+	unsigned int   m_overlaySrcId;
+	unsigned int   m_overlayDstId;
+	unsigned char  m_ysfCnt;
+	unsigned char  m_dmrCnt;
+	CFrameScheduler* m_ysfScheduler;
+	CFrameScheduler* m_dmrScheduler;
+	CDMRData       m_dmrHeader;
+	unsigned int   m_dmrHeaders;
+	unsigned int   m_dmrFill;
+	bool           m_dmrTerminator;
+	CTimer         m_networkWatchdog;
+
 	bool createDMRNetwork();
 	unsigned int findYSFID(std::string cs);
+
+	void processYSF(unsigned char* buffer);
+	void processDMR(const CDMRData& data);
+	void watchDMR(const CDMRData& data, unsigned int ms);
+	void writeDMR();
+	void writeDMREnd();
+	bool hasDMRToSend();
+	void createDMROverlays();
+	void addDMROverlay(unsigned char* data, unsigned int n) const;
+	void writeYSF();
+	void createYSFTemplates();
 };
 
 #endif
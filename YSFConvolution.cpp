@@ -22,6 +22,14 @@
 #include <cassert>
 #include <cstring>
 
+#if defined(CPU_X86)
+#include <emmintrin.h>
+#endif
+
+#if defined(CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
 
 #define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
@@ -36,23 +44,17 @@ const uint32_t     M = 2U;
 const unsigned int K = 5U;
 
 CYSFConvolution::CYSFConvolution() :
-m_metrics1(NULL),
-m_metrics2(NULL),
-m_oldMetrics(NULL),
-m_newMetrics(NULL),
-m_decisions(NULL),
-m_dp(NULL)
+m_metrics1(),
+m_metrics2(),
+m_oldMetrics(m_metrics1),
+m_newMetrics(m_metrics2),
+m_decisions(),
+m_dp(m_decisions)
 {
-	m_metrics1  = new uint16_t[16U];
-	m_metrics2  = new uint16_t[16U];
-	m_decisions = new uint64_t[180U];
 }
 
 CYSFConvolution::~CYSFConvolution()
 {
-	delete[] m_metrics1;
-	delete[] m_metrics2;
-	delete[] m_decisions;
 }
 
 void CYSFConvolution::start()
@@ -67,33 +69,157 @@ void CYSFConvolution::start()
 
 void CYSFConvolution::decode(uint8_t s0, uint8_t s1)
 {
-  *m_dp = 0U;
+	assert(s0 <= 1U && s1 <= 1U);
+
+	acs(s0, s0 ^ 1U, s1, s1 ^ 1U, M);
+}
+
+void CYSFConvolution::decodeSoft(uint8_t s0, uint8_t s1)
+{
+	assert(s0 <= VITERBI_SOFT_MAX && s1 <= VITERBI_SOFT_MAX);
+
+	// The distance from an expected 0 is the symbol, from an expected 1 its complement
+	acs(s0, VITERBI_SOFT_MAX - s0, s1, VITERBI_SOFT_MAX - s1, M * VITERBI_SOFT_MAX);
+}
+
+// One trellis step. The branch metric of butterfly i is d0 + d1, where d0 is
+// the distance of the first symbol from BRANCH_TABLE1[i] and d1 that of the
+// second symbol from BRANCH_TABLE2[i], the other branch costs m minus that.
+// On a tie the path from the upper half of the states is kept.
+static void acsScalar(const uint16_t* oldMetrics, uint16_t* newMetrics, uint16_t* dp, uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m)
+{
+	uint16_t decisions = 0U;
+
+	for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
+		uint8_t j = i * 2U;
+
+		uint16_t metric = (BRANCH_TABLE1[i] ? d01 : d00) + (BRANCH_TABLE2[i] ? d11 : d10);
+
+		uint16_t m0 = oldMetrics[i] + metric;
+		uint16_t m1 = oldMetrics[i + NUM_OF_STATES_D2] + (m - metric);
+		uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
+		newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+
+		m0 = oldMetrics[i] + (m - metric);
+		m1 = oldMetrics[i + NUM_OF_STATES_D2] + metric;
+		uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
+		newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+
+		decisions |= (decision1 << (j + 1U)) | (decision0 << (j + 0U));
+	}
+
+	*dp = decisions;
+}
+
+#if defined(CPU_X86)
+CPU_TARGET("sse2") static void acsSSE2(const uint16_t* oldMetrics, uint16_t* newMetrics, uint16_t* dp, uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m)
+{
+	// BRANCH_TABLE1 and BRANCH_TABLE2 as lane masks
+	const __m128i table1 = _mm_setr_epi16(0, 0, 0, 0, -1, -1, -1, -1);
+	const __m128i table2 = _mm_setr_epi16(0, -1, -1, 0, 0, -1, -1, 0);
+
+	__m128i metric = _mm_add_epi16(
+		_mm_or_si128(_mm_and_si128(table1, _mm_set1_epi16(d01)), _mm_andnot_si128(table1, _mm_set1_epi16(d00))),
+		_mm_or_si128(_mm_and_si128(table2, _mm_set1_epi16(d11)), _mm_andnot_si128(table2, _mm_set1_epi16(d10))));
+	__m128i other = _mm_sub_epi16(_mm_set1_epi16(m), metric);
+
+	__m128i lower = _mm_loadu_si128((const __m128i*)(oldMetrics + 0U));
+	__m128i upper = _mm_loadu_si128((const __m128i*)(oldMetrics + NUM_OF_STATES_D2));
+
+	// The metrics stay far below 32768, so the signed operations are safe
+	__m128i m1    = _mm_add_epi16(upper, other);
+	__m128i even  = _mm_min_epi16(_mm_add_epi16(lower, metric), m1);
+	__m128i dec0  = _mm_cmpeq_epi16(even, m1);
+
+	m1            = _mm_add_epi16(upper, metric);
+	__m128i odd   = _mm_min_epi16(_mm_add_epi16(lower, other), m1);
+	__m128i dec1  = _mm_cmpeq_epi16(odd, m1);
+
+	_mm_storeu_si128((__m128i*)(newMetrics + 0U), _mm_unpacklo_epi16(even, odd));
+	_mm_storeu_si128((__m128i*)(newMetrics + NUM_OF_STATES_D2), _mm_unpackhi_epi16(even, odd));
+
+	__m128i decisions = _mm_packs_epi16(_mm_unpacklo_epi16(dec0, dec1), _mm_unpackhi_epi16(dec0, dec1));
+	*dp = uint16_t(_mm_movemask_epi8(decisions));
+}
+#endif
+
+#if defined(CPU_ARM_NEON)
+// Adds up the eight lanes
+static inline uint16_t sumNEON(uint16x8_t v)
+{
+	uint16x4_t s = vadd_u16(vget_low_u16(v), vget_high_u16(v));
+	s = vpadd_u16(s, s);
+	s = vpadd_u16(s, s);
 
-  for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
-    uint8_t j = i * 2U;
+	return vget_lane_u16(s, 0);
+}
+
+static void acsNEON(const uint16_t* oldMetrics, uint16_t* newMetrics, uint16_t* dp, uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m)
+{
+	// BRANCH_TABLE1 and BRANCH_TABLE2 as lane masks, and the weight of each lane in the decisions
+	static const uint16_t TABLE1[]  = {0x0000U, 0x0000U, 0x0000U, 0x0000U, 0xFFFFU, 0xFFFFU, 0xFFFFU, 0xFFFFU};
+	static const uint16_t TABLE2[]  = {0x0000U, 0xFFFFU, 0xFFFFU, 0x0000U, 0x0000U, 0xFFFFU, 0xFFFFU, 0x0000U};
+	static const uint16_t WEIGHTS[] = {0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U};
 
-    uint16_t metric = (BRANCH_TABLE1[i] ^ s0) + (BRANCH_TABLE2[i] ^ s1);
+	uint16x8_t metric = vaddq_u16(
+		vbslq_u16(vld1q_u16(TABLE1), vdupq_n_u16(d01), vdupq_n_u16(d00)),
+		vbslq_u16(vld1q_u16(TABLE2), vdupq_n_u16(d11), vdupq_n_u16(d10)));
+	uint16x8_t other = vsubq_u16(vdupq_n_u16(m), metric);
 
-    uint16_t m0 = m_oldMetrics[i] + metric;
-    uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
-    uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+	uint16x8_t lower = vld1q_u16(oldMetrics + 0U);
+	uint16x8_t upper = vld1q_u16(oldMetrics + NUM_OF_STATES_D2);
 
-    m0 = m_oldMetrics[i] + (M - metric);
-    m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + metric;
-    uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+	uint16x8_t m1   = vaddq_u16(upper, other);
+	uint16x8_t even = vminq_u16(vaddq_u16(lower, metric), m1);
+	uint16x8_t dec0 = vceqq_u16(even, m1);
 
-    *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
-  }
+	m1              = vaddq_u16(upper, metric);
+	uint16x8_t odd  = vminq_u16(vaddq_u16(lower, other), m1);
+	uint16x8_t dec1 = vceqq_u16(odd, m1);
+
+	uint16x8x2_t metrics = vzipq_u16(even, odd);
+	vst1q_u16(newMetrics + 0U, metrics.val[0U]);
+	vst1q_u16(newMetrics + NUM_OF_STATES_D2, metrics.val[1U]);
+
+	uint16x8x2_t decisions = vzipq_u16(dec0, dec1);
+	uint16x8_t weights = vld1q_u16(WEIGHTS);
+	*dp = sumNEON(vandq_u16(decisions.val[0U], weights)) | (sumNEON(vandq_u16(decisions.val[1U], weights)) << 8);
+}
+#endif
+
+static void (*acsKernel)(const uint16_t* oldMetrics, uint16_t* newMetrics, uint16_t* dp, uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m) = acsScalar;
+
+void CYSFConvolution::setLevel(CPU_LEVEL level)
+{
+	switch (level) {
+#if defined(CPU_X86)
+		case CPU_SSE2:
+		case CPU_BMI2:
+			acsKernel = acsSSE2;
+			break;
+#endif
+#if defined(CPU_ARM_NEON)
+		case CPU_NEON:
+			acsKernel = acsNEON;
+			break;
+#endif
+		default:
+			acsKernel = acsScalar;
+			break;
+	}
+}
+
+void CYSFConvolution::acs(uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m)
+{
+	acsKernel(m_oldMetrics, m_newMetrics, m_dp, d00, d01, d10, d11, m);
 
-  ++m_dp;
+	++m_dp;
 
-  assert((m_dp - m_decisions) <= 180);
+	assert((m_dp - m_decisions) <= 180);
 
-  uint16_t* tmp = m_oldMetrics;
-  m_oldMetrics = m_newMetrics;
-  m_newMetrics = tmp;
+	uint16_t* tmp = m_oldMetrics;
+	m_oldMetrics = m_newMetrics;
+	m_newMetrics = tmp;
 }
 
 void CYSFConvolution::chainback(unsigned char* out, unsigned int nBits)
@@ -19,10 +19,13 @@
 #if !defined(YSFConvolution_H)
 #define  YSFConvolution_H
 
-#include "YSFConvolution.h"
+#include "CPU.h"
 
 #include <cstdint>
 
+// Soft symbols run from 0, a certain 0, to this value, a certain 1
+const uint8_t VITERBI_SOFT_MAX = 15U;
+
 class CYSFConvolution {
 public:
 	CYSFConvolution();
@@ -30,17 +33,23 @@ public:
 
 	void start();
 	void decode(uint8_t s0, uint8_t s1);
+	void decodeSoft(uint8_t s0, uint8_t s1);
 	void chainback(unsigned char* out, unsigned int nBits);
 
 	void encode(const unsigned char* in, unsigned char* out, unsigned int nBits) const;
 
+	// Selects the version of the add-compare-select step
+	static void setLevel(CPU_LEVEL level);
+
 private:
-	uint16_t* m_metrics1;
-	uint16_t* m_metrics2;
+	uint16_t  m_metrics1[16U];
+	uint16_t  m_metrics2[16U];
 	uint16_t* m_oldMetrics;
 	uint16_t* m_newMetrics;
-	uint64_t* m_decisions;
-	uint64_t* m_dp;
+	uint16_t  m_decisions[180U];
+	uint16_t* m_dp;
+
+	void acs(uint16_t d00, uint16_t d01, uint16_t d10, uint16_t d11, uint16_t m);
 };
 
 #endif
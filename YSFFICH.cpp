@@ -18,6 +18,7 @@
  */
 
 #include "YSFConvolution.h"
+#include "BitPermutation.h"
 #include "YSFDefines.h"
 #include "Golay24128.h"
 #include "YSFFICH.h"
@@ -28,11 +29,6 @@
 #include <cassert>
 #include <cstring>
 
-const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
-
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
-
 const unsigned int INTERLEAVE_TABLE[] = {
    0U, 40U,  80U, 120U, 160U,
    2U, 42U,  82U, 122U, 162U,
@@ -55,15 +51,16 @@ const unsigned int INTERLEAVE_TABLE[] = {
   36U, 76U, 116U, 156U, 196U,
   38U, 78U, 118U, 158U, 198U};
 
+// Pairs of convolved bits to and from their FICH positions
+static const CBitPermutation<100U, 2U> PERMUTATION(INTERLEAVE_TABLE);
+
 CYSFFICH::CYSFFICH() :
-m_fich(NULL)
+m_fich()
 {
-	m_fich  = new unsigned char[6U];
 }
 
 CYSFFICH::~CYSFFICH()
 {
-	delete[] m_fich;
 }
 
 bool CYSFFICH::decode(const unsigned char* bytes)
@@ -77,23 +74,28 @@ bool CYSFFICH::decode(const unsigned char* bytes)
 	viterbi.start();
 
 	// Deinterleave the FICH and send bits to the Viterbi decoder
-	for (unsigned int i = 0U; i < 100U; i++) {
-		unsigned int n = INTERLEAVE_TABLE[i];
-		uint8_t s0 = READ_BIT1(bytes, n) ? 1U : 0U;
+	unsigned char convolved[25U];
+	PERMUTATION.deinterleave(bytes, convolved);
 
-		n++;
-		uint8_t s1 = READ_BIT1(bytes, n) ? 1U : 0U;
+	for (unsigned int i = 0U; i < 25U; i++) {
+		unsigned char c = convolved[i];
 
-		viterbi.decode(s0, s1);
+		viterbi.decode((c >> 7) & 0x01U, (c >> 6) & 0x01U);
+		viterbi.decode((c >> 5) & 0x01U, (c >> 4) & 0x01U);
+		viterbi.decode((c >> 3) & 0x01U, (c >> 2) & 0x01U);
+		viterbi.decode((c >> 1) & 0x01U, (c >> 0) & 0x01U);
 	}
 
 	unsigned char output[13U];
 	viterbi.chainback(output, 96U);
 
-	unsigned int b0 = CGolay24128::decode24128(output + 0U);
-	unsigned int b1 = CGolay24128::decode24128(output + 3U);
-	unsigned int b2 = CGolay24128::decode24128(output + 6U);
-	unsigned int b3 = CGolay24128::decode24128(output + 9U);
+	unsigned int b[4U];
+	CGolay24128::decode24128(output, b, 4U);
+
+	unsigned int b0 = b[0U];
+	unsigned int b1 = b[1U];
+	unsigned int b2 = b[2U];
+	unsigned int b3 = b[3U];
 
 	m_fich[0U] = (b0 >> 4) & 0xFFU;
 	m_fich[1U] = ((b0 << 4) & 0xF0U) | ((b1 >> 8) & 0x0FU);
@@ -143,21 +145,7 @@ void CYSFFICH::encode(unsigned char* bytes)
 	unsigned char convolved[25U];
 	convolution.encode(conv, convolved, 100U);
 
-	unsigned int j = 0U;
-	for (unsigned int i = 0U; i < 100U; i++) {
-		unsigned int n = INTERLEAVE_TABLE[i];
-
-		bool s0 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		bool s1 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		WRITE_BIT1(bytes, n, s0);
-
-		n++;
-		WRITE_BIT1(bytes, n, s1);
-	}
+	PERMUTATION.interleave(convolved, bytes);
 }
 
 unsigned char CYSFFICH::getFI() const
@@ -305,3 +293,10 @@ void CYSFFICH::load(const unsigned char* fich)
 	::memcpy(m_fich, fich, 4U);
 }
 
+void CYSFFICH::save(unsigned char* fich) const
+{
+	assert(fich != NULL);
+
+	::memcpy(fich, m_fich, 4U);
+}
+
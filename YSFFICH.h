@@ -56,9 +56,10 @@ public:
 	void setSQ(unsigned char sq);
 
 	void load(const unsigned char* fich);
+	void save(unsigned char* fich) const;
 
 private:
-	unsigned char* m_fich;
+	unsigned char m_fich[6U];
 };
 
 #endif
@@ -0,0 +1,103 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "YSFFICHCache.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+
+CYSFFICHCache::CYSFFICHCache(unsigned int size) :
+m_mask(0U),
+m_entries(NULL),
+m_hits(0U),
+m_misses(0U)
+{
+	assert(size > 0U);
+
+	unsigned int n = 1U;
+	while (n < size)
+		n <<= 1;
+	m_mask = n - 1U;
+
+	m_entries = new CEntry[n];
+	for (unsigned int i = 0U; i < n; i++)
+		m_entries[i].m_used = false;
+}
+
+CYSFFICHCache::~CYSFFICHCache()
+{
+	delete[] m_entries;
+}
+
+bool CYSFFICHCache::decode(const unsigned char* bytes, CYSFFICH& fich)
+{
+	assert(bytes != NULL);
+
+	const unsigned char* raw = bytes + YSF_SYNC_LENGTH_BYTES;
+
+	unsigned int hash = 0U;
+	for (unsigned int i = 0U; i < YSF_FICH_LENGTH_BYTES; i++)
+		hash = (hash * 31U) ^ raw[i];
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	CEntry& entry = m_entries[hash & m_mask];
+
+	if (entry.m_used && ::memcmp(entry.m_raw, raw, YSF_FICH_LENGTH_BYTES) == 0) {
+		m_hits++;
+		fich.load(entry.m_fich);
+
+#if defined(VERIFY_FICH_CACHE)
+		// Built with make VERIFY_FICH_CACHE=1, checks the hit against a full decode
+		CYSFFICH check;
+		bool valid = check.decode(bytes);
+
+		unsigned char fields[4U];
+		check.save(fields);
+		if (!valid || ::memcmp(fields, entry.m_fich, 4U) != 0)
+			LogError("FICH cache hit does not match the full decode");
+#endif
+
+		return true;
+	}
+
+	m_misses++;
+
+	bool valid = fich.decode(bytes);
+	if (valid) {
+		::memcpy(entry.m_raw, raw, YSF_FICH_LENGTH_BYTES);
+		fich.save(entry.m_fich);
+		entry.m_used = true;
+	}
+
+	return valid;
+}
+
+void CYSFFICHCache::report()
+{
+	unsigned int total = m_hits + m_misses;
+	if (total == 0U)
+		return;
+
+	LogDebug("FICH cache: %u hits, %u misses, %.1f%% hit rate", m_hits, m_misses, float(m_hits) * 100.0F / float(total));
+
+	m_hits   = 0U;
+	m_misses = 0U;
+}
@@ -0,0 +1,56 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(YSFFICHCACHE_H)
+#define	YSFFICHCACHE_H
+
+#include "YSFDefines.h"
+#include "YSFFICH.h"
+
+// Remembers the decoded fields of recently seen FICHs, keyed on the 25
+// interleaved bytes as received. A call only uses a few FICHs, since the
+// frame number cycles and the rest stays the same, so most frames skip
+// the Viterbi and Golay decoding. Only FICHs that pass the CRC are kept.
+class CYSFFICHCache {
+public:
+	CYSFFICHCache(unsigned int size);
+	~CYSFFICHCache();
+
+	// As CYSFFICH::decode, the bytes start with the sync
+	bool decode(const unsigned char* bytes, CYSFFICH& fich);
+
+	// Logs the hit rate since the last report
+	void report();
+
+private:
+	struct CEntry {
+		bool          m_used;
+		unsigned char m_raw[YSF_FICH_LENGTH_BYTES];
+		unsigned char m_fich[4U];
+	};
+
+	unsigned int m_mask;
+	CEntry*      m_entries;
+	unsigned int m_hits;
+	unsigned int m_misses;
+
+	CYSFFICHCache(const CYSFFICHCache&);
+	CYSFFICHCache& operator=(const CYSFFICHCache&);
+};
+
+#endif
@@ -17,7 +17,10 @@
  */
 
 #include "YSFNetwork.h"
+#include "YSFPayload.h"
+#include "YSFFICH.h"
 #include "Utils.h"
+#include "Sync.h"
 #include "Log.h"
 
 #include <cstdio>
@@ -33,6 +36,8 @@ m_address(),
 m_port(0U),
 m_poll(NULL),
 m_unlink(NULL),
+m_header(),
+m_terminator(),
 m_buffer(1000U, "YSF Network Buffer")
 {
 	m_poll = new unsigned char[14U];
@@ -48,6 +53,9 @@ m_buffer(1000U, "YSF Network Buffer")
 		m_poll[i + 4U]   = m_callsign.at(i);
 		m_unlink[i + 4U] = m_callsign.at(i);
 	}
+
+	createFrame(m_header, YSF_FI_HEADER);
+	createFrame(m_terminator, YSF_FI_TERMINATOR);
 }
 
 CYSFNetwork::CYSFNetwork(unsigned int port, const std::string& callsign, bool debug) :
@@ -57,6 +65,8 @@ m_address(),
 m_port(0U),
 m_poll(NULL),
 m_unlink(NULL),
+m_header(),
+m_terminator(),
 m_buffer(1000U, "YSF Network Buffer")
 {
 	m_poll = new unsigned char[14U];
@@ -72,6 +82,9 @@ m_buffer(1000U, "YSF Network Buffer")
 		m_poll[i + 4U]   = m_callsign.at(i);
 		m_unlink[i + 4U] = m_callsign.at(i);
 	}
+
+	createFrame(m_header, YSF_FI_HEADER);
+	createFrame(m_terminator, YSF_FI_TERMINATOR);
 }
 
 CYSFNetwork::~CYSFNetwork()
@@ -84,6 +97,16 @@ std::string CYSFNetwork::getCallsign()
 	return m_callsign;
 }
 
+const unsigned char* CYSFNetwork::getHeader() const
+{
+	return m_header;
+}
+
+const unsigned char* CYSFNetwork::getTerminator() const
+{
+	return m_terminator;
+}
+
 bool CYSFNetwork::open()
 {
 	LogMessage("Opening YSF network connection");
@@ -111,9 +134,9 @@ bool CYSFNetwork::write(const unsigned char* data)
 		return true;
 
 	if (m_debug)
-		CUtils::dump(1U, "YSF Network Data Sent", data, 155U);
+		CUtils::dump(1U, "YSF Network Data Sent", data, YSF_PACKET_LENGTH);
 
-	return m_socket.write(data, 155U, m_address, m_port);
+	return m_socket.write(data, YSF_PACKET_LENGTH, m_address, m_port);
 }
 
 bool CYSFNetwork::writePoll()
@@ -172,9 +195,47 @@ unsigned int CYSFNetwork::read(unsigned char* data)
 	return len;
 }
 
+int CYSFNetwork::getFd() const
+{
+	return m_socket.getFd();
+}
+
 void CYSFNetwork::close()
 {
 	m_socket.close();
 
 	LogMessage("Closing YSF network connection");
 }
+
+void CYSFNetwork::createFrame(unsigned char* data, unsigned char fi)
+{
+	assert(data != NULL);
+
+	::memcpy(data + 0U, "YSFD", 4U);
+	::memcpy(data + 4U, m_callsign.c_str(), YSF_CALLSIGN_LENGTH);
+	::memcpy(data + 14U, m_callsign.c_str(), YSF_CALLSIGN_LENGTH);
+	::memcpy(data + 24U, "ALL       ", YSF_CALLSIGN_LENGTH);
+	data[34U] = 0U; // Net frame counter
+
+	CSync::addYSFSync(data + 35U);
+
+	CYSFFICH fich;
+	fich.setFI(fi);
+	fich.setCS(2U);
+	fich.setFN(0U);
+	fich.setFT(7U);
+	fich.setDev(0U);
+	fich.setMR(2U);
+	fich.setDT(YSF_DT_VD_MODE2);
+	fich.setSQL(0U);
+	fich.setSQ(0U);
+	fich.encode(data + 35U);
+
+	unsigned char csd1[20U], csd2[20U];
+	::memset(csd1, '*', YSF_CALLSIGN_LENGTH);
+	::memcpy(csd1 + YSF_CALLSIGN_LENGTH, m_callsign.c_str(), YSF_CALLSIGN_LENGTH);
+	::memset(csd2, ' ', YSF_CALLSIGN_LENGTH + YSF_CALLSIGN_LENGTH);
+
+	CYSFPayload payload;
+	payload.writeHeader(data + 35U, csd1, csd2);
+}
@@ -26,6 +26,8 @@
 #include <cstdint>
 #include <string>
 
+const unsigned int YSF_PACKET_LENGTH = 155U;
+
 class CYSFNetwork {
 public:
 	CYSFNetwork(const std::string& address, unsigned int port, const std::string& callsign, bool debug);
@@ -36,6 +38,11 @@ public:
 
 	std::string getCallsign();
 
+	// Complete network frames for the start and end of a call, only the
+	// frame counter at byte 34 needs to be set before they are sent
+	const unsigned char* getHeader() const;
+	const unsigned char* getTerminator() const;
+
 	void setDestination(const in_addr& address, unsigned int port);
 	void clearDestination();
 
@@ -48,6 +55,8 @@ public:
 
 	void clock(unsigned int ms);
 
+	int  getFd() const;
+
 	void close();
 
 private:
@@ -58,7 +67,11 @@ private:
 	unsigned int               m_port;
 	unsigned char*             m_poll;
 	unsigned char*             m_unlink;
+	unsigned char              m_header[YSF_PACKET_LENGTH];
+	unsigned char              m_terminator[YSF_PACKET_LENGTH];
 	CRingBuffer<unsigned char> m_buffer;
+
+	void createFrame(unsigned char* data, unsigned char fi);
 };
 
 #endif
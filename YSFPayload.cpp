@@ -13,6 +13,7 @@
 */
 
 #include "YSFConvolution.h"
+#include "BitPermutation.h"
 #include "YSFPayload.h"
 #include "YSFDefines.h"
 #include "Utils.h"
@@ -72,25 +73,33 @@ const unsigned int INTERLEAVE_TABLE_5_20[] = {
 const unsigned char WHITENING_DATA[] = {0x93U, 0xD7U, 0x51U, 0x21U, 0x9CU, 0x2FU, 0x6CU, 0xD0U, 0xEFU, 0x0FU,
 										0xF8U, 0x3DU, 0xF1U, 0x73U, 0x20U, 0x94U, 0xEDU, 0x1EU, 0x7CU, 0xD8U};
 
-const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+// Pairs of convolved bits to and from their DCH positions
+static const CBitPermutation<180U, 2U> PERMUTATION_9_20(INTERLEAVE_TABLE_9_20);
+static const CBitPermutation<100U, 2U> PERMUTATION_5_20(INTERLEAVE_TABLE_5_20);
 
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+// Sends a deinterleaved stream to the Viterbi decoder a dibit at a time
+static void decodeDibits(CYSFConvolution& conv, const unsigned char* in, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++) {
+		unsigned char c = in[i];
+
+		conv.decode((c >> 7) & 0x01U, (c >> 6) & 0x01U);
+		conv.decode((c >> 5) & 0x01U, (c >> 4) & 0x01U);
+		conv.decode((c >> 3) & 0x01U, (c >> 2) & 0x01U);
+		conv.decode((c >> 1) & 0x01U, (c >> 0) & 0x01U);
+	}
+}
 
 CYSFPayload::CYSFPayload() :
-m_uplink(NULL),
-m_downlink(NULL),
-m_source(NULL),
-m_dest(NULL)
+m_hasUplink(false),
+m_hasDownlink(false),
+m_hasSource(false),
+m_hasDest(false)
 {
 }
 
 CYSFPayload::~CYSFPayload()
 {
-	delete[] m_uplink;
-	delete[] m_downlink;
-	delete[] m_source;
-	delete[] m_dest;
 }
 
 bool CYSFPayload::processHeaderData(unsigned char* data)
@@ -99,44 +108,22 @@ bool CYSFPayload::processHeaderData(unsigned char* data)
 
 	data += YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES;
 
-	unsigned char dch[45U];
-
-	unsigned char* p1 = data;
-	unsigned char* p2 = dch;
-	for (unsigned int i = 0U; i < 5U; i++) {
-		::memcpy(p2, p1, 9U);
-		p1 += 18U; p2 += 9U;
-	}
-
 	CYSFConvolution conv;
-	conv.start();
-
-	for (unsigned int i = 0U; i < 180U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_9_20[i];
-		uint8_t s0 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		n++;
-		uint8_t s1 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		conv.decode(s0, s1);
-	}
 
 	unsigned char output[23U];
-	conv.chainback(output, 176U);
-
-	bool valid1 = CCRC::checkCCITT162(output, 22U);
+	bool valid1 = decodeDataFRModeData(data, output);
 	if (valid1) {
 		for (unsigned int i = 0U; i < 20U; i++)
 			output[i] ^= WHITENING_DATA[i];
 
-		if (m_dest == NULL) {
-			m_dest = new unsigned char[YSF_CALLSIGN_LENGTH];
+		if (!m_hasDest) {
 			::memcpy(m_dest, output + 0U, YSF_CALLSIGN_LENGTH);
+			m_hasDest = true;
 		}
 
-		if (m_source == NULL) {
-			m_source = new unsigned char[YSF_CALLSIGN_LENGTH];
+		if (!m_hasSource) {
 			::memcpy(m_source, output + YSF_CALLSIGN_LENGTH, YSF_CALLSIGN_LENGTH);
+			m_hasSource = true;
 		}
 
 		for (unsigned int i = 0U; i < 20U; i++)
@@ -149,60 +136,25 @@ bool CYSFPayload::processHeaderData(unsigned char* data)
 		conv.encode(output, convolved, 180U);
 
 		unsigned char bytes[45U];
-		unsigned int j = 0U;
-		for (unsigned int i = 0U; i < 180U; i++) {
-			unsigned int n = INTERLEAVE_TABLE_9_20[i];
-
-			bool s0 = READ_BIT1(convolved, j) != 0U;
-			j++;
-
-			bool s1 = READ_BIT1(convolved, j) != 0U;
-			j++;
-
-			WRITE_BIT1(bytes, n, s0);
-
-			n++;
-			WRITE_BIT1(bytes, n, s1);
-		}
+		PERMUTATION_9_20.interleave(convolved, bytes);
 
-		p1 = data;
-		p2 = bytes;
+		unsigned char* p1 = data;
+		unsigned char* p2 = bytes;
 		for (unsigned int i = 0U; i < 5U; i++) {
 			::memcpy(p1, p2, 9U);
 			p1 += 18U; p2 += 9U;
 		}
 	}
 
-	p1 = data + 9U;
-	p2 = dch;
-	for (unsigned int i = 0U; i < 5U; i++) {
-		::memcpy(p2, p1, 9U);
-		p1 += 18U; p2 += 9U;
-	}
-
-	conv.start();
-
-	for (unsigned int i = 0U; i < 180U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_9_20[i];
-		uint8_t s0 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		n++;
-		uint8_t s1 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		conv.decode(s0, s1);
-	}
-
-	conv.chainback(output, 176U);
-
-	bool valid2 = CCRC::checkCCITT162(output, 22U);
+	bool valid2 = decodeDataFRModeData(data + 9U, output);
 	if (valid2) {
 		for (unsigned int i = 0U; i < 20U; i++)
 			output[i] ^= WHITENING_DATA[i];
 
-		if (m_downlink != NULL)
+		if (m_hasDownlink)
 			::memcpy(output + 0U, m_downlink, YSF_CALLSIGN_LENGTH);
 
-		if (m_uplink != NULL)
+		if (m_hasUplink)
 			::memcpy(output + YSF_CALLSIGN_LENGTH, m_uplink, YSF_CALLSIGN_LENGTH);
 
 		for (unsigned int i = 0U; i < 20U; i++)
@@ -215,24 +167,10 @@ bool CYSFPayload::processHeaderData(unsigned char* data)
 		conv.encode(output, convolved, 180U);
 
 		unsigned char bytes[45U];
-		unsigned int j = 0U;
-		for (unsigned int i = 0U; i < 180U; i++) {
-			unsigned int n = INTERLEAVE_TABLE_9_20[i];
-
-			bool s0 = READ_BIT1(convolved, j) != 0U;
-			j++;
-
-			bool s1 = READ_BIT1(convolved, j) != 0U;
-			j++;
-
-			WRITE_BIT1(bytes, n, s0);
-
-			n++;
-			WRITE_BIT1(bytes, n, s1);
-		}
+		PERMUTATION_9_20.interleave(convolved, bytes);
 
-		p1 = data + 9U;
-		p2 = bytes;
+		unsigned char* p1 = data + 9U;
+		unsigned char* p2 = bytes;
 		for (unsigned int i = 0U; i < 5U; i++) {
 			::memcpy(p1, p2, 9U);
 			p1 += 18U; p2 += 9U;
@@ -242,6 +180,52 @@ bool CYSFPayload::processHeaderData(unsigned char* data)
 	return valid1;
 }
 
+bool CYSFPayload::readHeaderData(const unsigned char* data)
+{
+	assert(data != NULL);
+
+	data += YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES;
+
+	unsigned char output[23U];
+	bool valid = decodeDataFRModeData(data, output);
+	if (valid) {
+		for (unsigned int i = 0U; i < 20U; i++)
+			output[i] ^= WHITENING_DATA[i];
+
+		::memcpy(m_dest, output + 0U, YSF_CALLSIGN_LENGTH);
+		m_hasDest = true;
+
+		::memcpy(m_source, output + YSF_CALLSIGN_LENGTH, YSF_CALLSIGN_LENGTH);
+		m_hasSource = true;
+	}
+
+	return valid;
+}
+
+// Decodes the half of a header or terminator DCH that starts at data, the other half is skipped
+bool CYSFPayload::decodeDataFRModeData(const unsigned char* data, unsigned char* output)
+{
+	unsigned char dch[45U];
+
+	const unsigned char* p1 = data;
+	unsigned char* p2 = dch;
+	for (unsigned int i = 0U; i < 5U; i++) {
+		::memcpy(p2, p1, 9U);
+		p1 += 18U; p2 += 9U;
+	}
+
+	CYSFConvolution conv;
+	conv.start();
+
+	unsigned char deinterleaved[45U];
+	PERMUTATION_9_20.deinterleave(dch, deinterleaved);
+	decodeDibits(conv, deinterleaved, 45U);
+
+	conv.chainback(output, 176U);
+
+	return CCRC::checkCCITT162(output, 22U);
+}
+
 void CYSFPayload::writeVDMode2Data(unsigned char* data, const unsigned char* dt)
 {
 	data += YSF_SYNC_LENGTH_BYTES + YSF_FICH_LENGTH_BYTES;
@@ -261,21 +245,7 @@ void CYSFPayload::writeVDMode2Data(unsigned char* data, const unsigned char* dt)
 	conv.encode(dt_tmp, convolved, 100U);
 
 	unsigned char bytes[25U];
-	unsigned int j = 0U;
-	for (unsigned int i = 0U; i < 100U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_5_20[i];
-
-		bool s0 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		bool s1 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		WRITE_BIT1(bytes, n, s0);
-
-		n++;
-		WRITE_BIT1(bytes, n, s1);
-	}
+	PERMUTATION_5_20.interleave(convolved, bytes);
 
 	unsigned char* p1 = data;
 	unsigned char* p2 = bytes;
@@ -304,15 +274,9 @@ bool CYSFPayload::readVDMode2Data(const unsigned char* data, unsigned char* dt)
 	CYSFConvolution conv;
 	conv.start();
 
-	for (unsigned int i = 0U; i < 100U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_5_20[i];
-		uint8_t s0 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		n++;
-		uint8_t s1 = READ_BIT1(dch, n) ? 1U : 0U;
-
-		conv.decode(s0, s1);
-	}
+	unsigned char deinterleaved[25U];
+	PERMUTATION_5_20.deinterleave(dch, deinterleaved);
+	decodeDibits(conv, deinterleaved, 25U);
 
 	unsigned char output[13U];
 	conv.chainback(output, 96U);
@@ -361,21 +325,7 @@ void CYSFPayload::writeDataFRModeData1(const unsigned char* dt, unsigned char* d
 	conv.encode(output, convolved, 180U);
 
 	unsigned char bytes[45U];
-	unsigned int j = 0U;
-	for (unsigned int i = 0U; i < 180U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_9_20[i];
-
-		bool s0 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		bool s1 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		WRITE_BIT1(bytes, n, s0);
-
-		n++;
-		WRITE_BIT1(bytes, n, s1);
-	}
+	PERMUTATION_9_20.interleave(convolved, bytes);
 
 	unsigned char* p1 = data;
 	unsigned char* p2 = bytes;
@@ -405,21 +355,7 @@ void CYSFPayload::writeDataFRModeData2(const unsigned char* dt, unsigned char* d
 	conv.encode(output, convolved, 180U);
 
 	unsigned char bytes[45U];
-	unsigned int j = 0U;
-	for (unsigned int i = 0U; i < 180U; i++) {
-		unsigned int n = INTERLEAVE_TABLE_9_20[i];
-
-		bool s0 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		bool s1 = READ_BIT1(convolved, j) != 0U;
-		j++;
-
-		WRITE_BIT1(bytes, n, s0);
-
-		n++;
-		WRITE_BIT1(bytes, n, s1);
-	}
+	PERMUTATION_9_20.interleave(convolved, bytes);
 
 	unsigned char* p1 = data + 9U;
 	unsigned char* p2 = bytes;
@@ -431,31 +367,31 @@ void CYSFPayload::writeDataFRModeData2(const unsigned char* dt, unsigned char* d
 
 void CYSFPayload::setUplink(const std::string& callsign)
 {
-	m_uplink = new unsigned char[YSF_CALLSIGN_LENGTH];
-
 	std::string uplink = callsign;
 	uplink.resize(YSF_CALLSIGN_LENGTH, ' ');
 
 	for (unsigned int i = 0U; i < YSF_CALLSIGN_LENGTH; i++)
 		m_uplink[i] = uplink.at(i);
+
+	m_hasUplink = true;
 }
 
 void CYSFPayload::setDownlink(const std::string& callsign)
 {
-	m_downlink = new unsigned char[YSF_CALLSIGN_LENGTH];
-
 	std::string downlink = callsign;
 	downlink.resize(YSF_CALLSIGN_LENGTH, ' ');
 
 	for (unsigned int i = 0U; i < YSF_CALLSIGN_LENGTH; i++)
 		m_downlink[i] = downlink.at(i);
+
+	m_hasDownlink = true;
 }
 
 std::string CYSFPayload::getSource()
 {
 	std::string tmp;
 
-	if (m_dest)
+	if (m_hasSource)
 		tmp.assign((const char *)m_source, YSF_CALLSIGN_LENGTH);
 	else
 		tmp = "";
@@ -467,7 +403,7 @@ std::string CYSFPayload::getDest()
 {
 	std::string tmp;
 
-	if (m_dest)
+	if (m_hasDest)
 		tmp.assign((const char *)m_dest, YSF_CALLSIGN_LENGTH);
 	else
 		tmp = "";
@@ -477,9 +413,6 @@ std::string CYSFPayload::getDest()
 
 void CYSFPayload::reset()
 {
-	delete[] m_source;
-	delete[] m_dest;
-
-	m_source = NULL;
-	m_dest = NULL;
+	m_hasSource = false;
+	m_hasDest   = false;
 }
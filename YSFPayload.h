@@ -19,6 +19,8 @@
 #if !defined(YSFPayload_H)
 #define	YSFPayload_H
 
+#include "YSFDefines.h"
+
 #include <string>
 
 class CYSFPayload {
@@ -28,6 +30,9 @@ public:
 
 	bool processHeaderData(unsigned char* bytes);
 
+	// Decodes only the callsigns of a header, the frame is not changed
+	bool readHeaderData(const unsigned char* data);
+
 	void writeVDMode2Data(unsigned char* data, const unsigned char* dt);
 	bool readVDMode2Data(const unsigned char* data, unsigned char* dt);
 
@@ -45,10 +50,16 @@ public:
 	void reset();
 
 private:
-	unsigned char* m_uplink;
-	unsigned char* m_downlink;
-	unsigned char* m_source;
-	unsigned char* m_dest;
+	unsigned char m_uplink[YSF_CALLSIGN_LENGTH];
+	unsigned char m_downlink[YSF_CALLSIGN_LENGTH];
+	unsigned char m_source[YSF_CALLSIGN_LENGTH];
+	unsigned char m_dest[YSF_CALLSIGN_LENGTH];
+	bool          m_hasUplink;
+	bool          m_hasDownlink;
+	bool          m_hasSource;
+	bool          m_hasDest;
+
+	static bool decodeDataFRModeData(const unsigned char* data, unsigned char* output);
 };
 
 #endif